@@ -7,7 +7,92 @@
 
 #include "ADC.h"
 
-static circBuf_t g_inBuffer;        // Create buffer instance
+static circBuf16_t g_inBuffer;      // Create buffer instance
+static uint32_t g_inData[CIRCBUF16_WORDS(BUF_SIZE)];  // Statically allocated packed storage
+static volatile uint32_t g_inSum;   // Running sum of the buffer contents
+
+static bool altPrimed = false;     // Pre-filters settled at the first sample
+
+static uint16_t rawPrev = 0;                    // Last raw sample from either converter
+static volatile uint32_t rawChanges = 0;        // Raw samples that differed from the one before
+
+#if ALT_FILTER_MEDIAN
+static uint16_t medianHist[ALT_MEDIAN_LEN];     // Last raw samples, oldest overwritten
+static uint8_t medianIndex = 0;
+static volatile uint32_t spikeCount = 0;
+#endif
+
+#if ALT_FILTER_BIQUAD
+static biquad_t altFilter[ALT_BIQUAD_SECTIONS];
+#endif
+
+
+#if ALT_FILTER_MEDIAN
+#define SORT2(a, b) if ((a) > (b)) { uint16_t t = (a); (a) = (b); (b) = t; }
+
+// ************************************************************
+// median5: Median of the last five samples by a seven exchange sorting network
+static uint16_t
+median5 (const uint16_t *hist)
+{
+    uint16_t p0 = hist[0], p1 = hist[1], p2 = hist[2], p3 = hist[3], p4 = hist[4];
+
+    SORT2(p0, p1); SORT2(p3, p4); SORT2(p0, p3);
+    SORT2(p1, p4); SORT2(p1, p2); SORT2(p2, p3);
+    SORT2(p1, p2);
+    return p2;
+}
+#endif
+
+
+#if !ALT_ACQ_PWM_SYNC
+// ************************************************************
+// initADC0Trigger: Run the spare PWM generator at SAMPLE_RATE_HZ, counting down from the
+// system clock with no outputs, and have its counter zero trigger ADC0.
+static void
+initADC0Trigger (void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0);
+    PWMGenConfigure(ALT_ADC0_PWM_BASE, ALT_ADC0_PWM_GEN, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_NO_SYNC);
+    PWMGenPeriodSet(ALT_ADC0_PWM_BASE, ALT_ADC0_PWM_GEN, SysCtlClockGet() / SAMPLE_RATE_HZ);
+    PWMGenIntTrigEnable(ALT_ADC0_PWM_BASE, ALT_ADC0_PWM_GEN, PWM_TR_CNT_ZERO);
+    PWMGenEnable(ALT_ADC0_PWM_BASE, ALT_ADC0_PWM_GEN);
+}
+#endif
+
+
+#if ALT_DUAL_ADC
+// ************************************************************
+// initADC1: ADC1 samples the same channel on a timer trigger. The timer runs at ADC0's
+// rate from the same clock and is started half way through ADC0's trigger period, so its
+// conversions land midway between ADC0's for good. Call with the ADC0 trigger running.
+static void
+initADC1 (void)
+{
+    uint32_t period = SysCtlClockGet() / SAMPLE_RATE_HZ;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
+    SysCtlPeripheralEnable(ALT_ADC1_TIMER_PERIPH);
+
+    ADCSequenceConfigure(ADC1_BASE, ADC_SEQUENCE_NUM, ADC_TRIGGER_TIMER, ADC_SEQUENCE_STEP);
+    ADCSequenceStepConfigure(ADC1_BASE, ADC_SEQUENCE_NUM, ADC_SEQUENCE_STEP, ADC_CTL_CH9 | ADC_CTL_IE |
+                             ADC_CTL_END);
+    ADCSequenceEnable(ADC1_BASE, ADC_SEQUENCE_NUM);
+    ADCIntRegister (ADC1_BASE, ADC_SEQUENCE_NUM, ADC1IntHandler);
+    ADCIntEnable(ADC1_BASE, ADC_SEQUENCE_NUM);
+
+    TimerConfigure(ALT_ADC1_TIMER_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(ALT_ADC1_TIMER_BASE, TIMER_A, period - 1);
+    TimerControlTrigger(ALT_ADC1_TIMER_BASE, TIMER_A, true);
+
+    //The ADC0 generator counts down, wait for it to cross half way then start the timer
+    while (HWREG(ALT_ADC0_PWM_COUNT) < period / 2) {
+    }
+    while (HWREG(ALT_ADC0_PWM_COUNT) >= period / 2) {
+    }
+    TimerEnable(ALT_ADC1_TIMER_BASE, TIMER_A);
+}
+#endif
 
 
 //*****************************************************************************
@@ -26,10 +111,14 @@ initADC (void)
     // The ADC0 peripheral must be enabled for configuration and use.
     SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
 
-    // Enable sample sequence 3 with a processor signal trigger.  Sequence 3
-    // will do a single sample when the processor sends a signal to start the
-    // conversion.
-    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, ADC_TRIGGER_PROCESSOR, ADC_SEQUENCE_STEP);
+    // Enable sample sequence 3 with a hardware trigger.  Sequence 3
+    // will do a single sample each time the trigger fires.
+#if ALT_ACQ_PWM_SYNC
+    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, ALT_PWM_TRIGGER, ADC_SEQUENCE_STEP);
+    ADCHardwareOversampleConfigure(ADC0_BASE, ALT_PWM_OVERSAMPLE);
+#else
+    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, ALT_ADC0_TRIGGER, ADC_SEQUENCE_STEP);
+#endif
 
     //
     // Configure step 0 on sequence 3.  Sample channel 0 (ADC_CTL_CH0) in
@@ -56,7 +145,86 @@ initADC (void)
     ADCIntEnable(ADC0_BASE, ADC_SEQUENCE_NUM);
 
     //Initialise the circular buffer
-    initCircBuf (&g_inBuffer, BUF_SIZE);
+    initCircBuf16 (&g_inBuffer, g_inData, ALT_MEAN_LEN);
+
+#if ALT_FILTER_BIQUAD
+    //Notch then low pass, designed for the merged sample rate
+    biquadNotch(&altFilter[0], ALT_NOTCH_HZ, ALT_NOTCH_Q, ALT_SAMPLE_RATE_HZ);
+    biquadLowPass(&altFilter[1], ALT_LOWPASS_HZ, ALT_LOWPASS_Q, ALT_SAMPLE_RATE_HZ);
+#endif
+
+#if !ALT_ACQ_PWM_SYNC
+    initADC0Trigger();
+#endif
+#if ALT_DUAL_ADC
+    initADC1();
+#endif
+
+#if ALT_ACQ_PWM_SYNC
+    //Have the main rotor generator trigger conversions, independent of its set up in
+    //initialisePWM() which leaves the trigger enables alone
+    SysCtlPeripheralEnable(PWM_MAIN_PERIPH_PWM);
+    PWMGenIntTrigEnable(PWM_MAIN_BASE, PWM_MAIN_GEN, PWM_TR_CNT_ZERO | PWM_TR_CNT_LOAD);
+#endif
+}
+
+
+// ************************************************************
+// altSample: Filter one sample from either converter and add it to the
+// circular buffer. Both ADC interrupts share a priority so samples arrive in order.
+static void
+altSample (uint32_t ulValue)
+{
+    //
+    // Start the pre-filters settled at the first sample
+    if (!altPrimed) {
+#if ALT_FILTER_MEDIAN
+        uint8_t j;
+        for (j = 0; j < ALT_MEDIAN_LEN; j++) {
+            medianHist[j] = ulValue;
+        }
+#endif
+#if ALT_FILTER_BIQUAD
+        uint8_t i;
+        for (i = 0; i < ALT_BIQUAD_SECTIONS; i++) {
+            biquadReset(&altFilter[i], ulValue << ALT_FILTER_SHIFT);
+        }
+#endif
+        rawPrev = ulValue;
+        altPrimed = true;
+    }
+
+    //
+    // Count raw changes for the stuck sensor check, the filters below hide a dead input
+    if (ulValue != rawPrev) {
+        rawChanges++;
+        rawPrev = ulValue;
+    }
+
+#if ALT_FILTER_MEDIAN
+    //
+    // Reject single sample spikes, counting samples the median disagrees with
+    medianHist[medianIndex] = ulValue;
+    medianIndex = (medianIndex + 1) % ALT_MEDIAN_LEN;
+    uint16_t median = median5(medianHist);
+    int32_t deviation = (int32_t) ulValue - median;
+    if (deviation > ALT_SPIKE_COUNTS || deviation < -ALT_SPIKE_COUNTS) {
+        spikeCount++;
+    }
+    ulValue = median;
+#endif
+
+#if ALT_FILTER_BIQUAD
+    //
+    // Notch and low pass the sample
+    int16_t filtered = biquadCascade(altFilter, ALT_BIQUAD_SECTIONS, ulValue << ALT_FILTER_SHIFT);
+    ulValue = filtered < 0 ? 0 : (filtered + (1 << (ALT_FILTER_SHIFT - 1))) >> ALT_FILTER_SHIFT;
+#endif
+    //
+    // Place it in the circular buffer (advancing write index) and swap
+    // it for the oldest sample in the running sum, exact in integers so it never drifts
+    g_inSum += ulValue - writeCircBuf16(&g_inBuffer, ulValue);
+    publishAlt(getAltMean());
 }
 
 
@@ -74,32 +242,53 @@ ADCIntHandler(void)
     // Get the single sample from ADC0.  ADC_BASE is defined in
     // inc/hw_memmap.h
     ADCSequenceDataGet(ADC0_BASE, ADC_SEQUENCE_NUM, &ulValue);
-    //
-    // Place it in the circular buffer (advancing write index)
-    writeCircBuf(&g_inBuffer, ulValue);
+
+    altSample(ulValue);
     //
     // Clean up, clearing the interrupt
     ADCIntClear(ADC0_BASE, ADC_SEQUENCE_NUM);
 }
 
+#if ALT_DUAL_ADC
 // ************************************************************
-// getAltMean: Calculates the mean altitude from a circular buffer.
-// Assumes g_inBuffer is initialized and BUF_SIZE is defined.
+// ADC1IntHandler: As ADCIntHandler for the interleaved conversions on ADC1.
+void
+ADC1IntHandler(void)
+{
+    uint32_t ulValue;
+
+    ADCSequenceDataGet(ADC1_BASE, ADC_SEQUENCE_NUM, &ulValue);
+    altSample(ulValue);
+    ADCIntClear(ADC1_BASE, ADC_SEQUENCE_NUM);
+}
+#endif
+
+// ************************************************************
+// getAltMean: Mean altitude of the circular buffer, kept up to date
+// by ADCIntHandler which also publishes it to the sensor snapshot.
 uint16_t 
 getAltMean (void) {
-    uint16_t i;
-    uint32_t sum = 0;
-    for (i = 0; i < BUF_SIZE; i++) {
-        sum += readCircBuf(&g_inBuffer);
-    }
-    uint16_t currentMean = (2 * sum + BUF_SIZE) / 2 / BUF_SIZE;
+    uint16_t currentMean = (2 * g_inSum + ALT_MEAN_LEN) / 2 / ALT_MEAN_LEN;
     return currentMean;
 }
 
 
+// ************************************************************
+// getSpikeCount: Number of samples rejected by the median pre-filter since power on
+uint32_t
+getSpikeCount (void) {
+#if ALT_FILTER_MEDIAN
+    return spikeCount;
+#else
+    return 0;
+#endif
+}
 
 
-
-
-
-
+// ************************************************************
+// getAltRawChanges: Number of raw samples that differed from the previous one since power on.
+// A live sensor's noise changes the low bits every few samples.
+uint32_t
+getAltRawChanges (void) {
+    return rawChanges;
+}
@@ -11,18 +11,74 @@
 #include "driverlib/adc.h"
 #include "driverlib/sysctl.h"
 #include "circBufT.h"
+#include "memPlan.h"
+#include "sensorState.h"
+#include "biquad.h"
+#include "driverlib/timer.h"
+#include "driverlib/systick.h"
+#include "driverlib/pwm.h"
+#include "pwmDriver.h"
 
 
 //*****************************************************************************
 // Constants
 //*****************************************************************************
-#define BUF_SIZE 60
 #define SAMPLE_RATE_HZ 1000
 
 // ADC configuration
 #define ADC_SEQUENCE_NUM         3    // ADC sequence number
 #define ADC_SEQUENCE_STEP        0    // Step index for ADC sequence
 
+// PWM synchronised acquisition. ADC0 converts at the main rotor generator's counter zero and
+// load, the middle of the off and on times, where both rotors are furthest from switching.
+// Both generators run in phase at the same rate, so this holds for the tail too. Each
+// trigger averages ALT_PWM_OVERSAMPLE conversions in hardware, well clear of the next edge.
+#ifndef ALT_ACQ_PWM_SYNC
+#define ALT_ACQ_PWM_SYNC 0          // Set to 1 to trigger from the rotor PWM instead of a clock
+#endif
+#define ALT_PWM_TRIGGER ADC_TRIGGER_PWM3    // PWM0 generator 3, the main rotor
+#define ALT_PWM_OVERSAMPLE 16
+
+// Otherwise ADC0 converts at SAMPLE_RATE_HZ on counter zero of a spare PWM generator with no
+// pins, a hardware trigger with no interrupt latency in it. Every timer's ADC trigger reaches
+// both converters on this part, so the timer is kept for ADC1 alone.
+#define ALT_ADC0_PWM_BASE PWM0_BASE
+#define ALT_ADC0_PWM_GEN PWM_GEN_0
+#define ALT_ADC0_PWM_COUNT (PWM0_BASE + PWM_O_0_COUNT)
+#define ALT_ADC0_TRIGGER ADC_TRIGGER_PWM0
+
+// Second converter on the same channel, timer triggered half a period after ADC0, merged
+// into one sample stream at twice SAMPLE_RATE_HZ. Both triggers count the system clock so
+// the offset is fixed from start up. Clock triggered acquisition only.
+#define ALT_DUAL_ADC (1 && !ALT_ACQ_PWM_SYNC)   // Set to 0 for ADC0 alone
+#define ALT_ADC1_TIMER_PERIPH SYSCTL_PERIPH_TIMER0
+#define ALT_ADC1_TIMER_BASE TIMER0_BASE
+
+#if ALT_ACQ_PWM_SYNC
+#define ALT_SAMPLE_RATE_HZ (2 * PWM_MAIN_FREQ)
+#define ALT_MEAN_LEN 18             // Samples averaged, 30 ms
+#elif ALT_DUAL_ADC
+#define ALT_SAMPLE_RATE_HZ (2 * SAMPLE_RATE_HZ)
+#define ALT_MEAN_LEN BUF_SIZE
+#else
+#define ALT_SAMPLE_RATE_HZ SAMPLE_RATE_HZ
+#define ALT_MEAN_LEN BUF_SIZE
+#endif
+
+// Running median of 5 on each altitude sample, ahead of the biquads, to reject spikes
+#define ALT_FILTER_MEDIAN 1         // Set to 0 to pass spikes through
+#define ALT_MEDIAN_LEN 5            // Fixed by the sorting network in median5()
+#define ALT_SPIKE_COUNTS 50         // ~4%, sample to median difference counted as a spike
+
+// Biquad pre-filter on each altitude sample, ahead of the averaging buffer
+#define ALT_FILTER_BIQUAD 1         // Set to 0 to average raw samples
+#define ALT_FILTER_SHIFT 2          // Sample fraction bits kept through the filter
+#define ALT_NOTCH_HZ 50.0f          // Rotor vibration notch
+#define ALT_NOTCH_Q 2.0f
+#define ALT_LOWPASS_HZ 40.0f        // PWM and switching noise low pass, ~6 ms of lag
+#define ALT_LOWPASS_Q 0.707f
+#define ALT_BIQUAD_SECTIONS 2
+
 
 
 #ifndef ADC_H_
@@ -32,6 +88,8 @@
 
 void ADCIntHandler(void);
 
+void ADC1IntHandler(void);
+
 //*****************************************************************************
 // initADC: The handler for the ADC conversion complete interrupt.
 // Writes to the circular buffer.
@@ -39,10 +97,14 @@ void ADCIntHandler(void);
 void initADC (void);
 
 // ************************************************************
-// getAltMean: Calculates the mean altitude from a circular buffer.
-// Assumes g_inBuffer is initialized and BUF_SIZE is defined.
+// getAltMean: Mean altitude of the circular buffer, kept up to date
+// by ADCIntHandler which also publishes it to the sensor snapshot.
 uint16_t getAltMean (void);
 
+uint32_t getSpikeCount (void);
+
+uint32_t getAltRawChanges (void);
+
 void SysTickIntHandler(void);
 
 #endif /* ADC_H_ */
@@ -33,6 +33,7 @@
 //*****************************************************************************
 // Global variables
 //*****************************************************************************
+static uint32_t g_inData[BUF_SIZE];
 static circBuf_t g_inBuffer;		// Buffer of size BUF_SIZE integers (sample values)
 static uint32_t g_ulSampCnt;	// Counter for the interrupts
 
@@ -172,7 +173,7 @@ main(void)
 	initClock ();
 	initADC ();
 	initDisplay ();
-	initCircBuf (&g_inBuffer, BUF_SIZE);
+	initCircBuf (&g_inBuffer, g_inData, BUF_SIZE);
 
     //
     // Enable interrupts to the processor.
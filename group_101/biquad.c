@@ -0,0 +1,103 @@
+/*
+ * biquad.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <math.h>
+#include "biquad.h"
+
+#define PI_F 3.14159265f
+
+//Quantise normalised coefficients to Q14. b1 absorbs the rounding so the DC gain,
+//sum(b) / (1 + a1 + a2), is exactly that of the floating point design.
+static void
+setCoefficients (biquad_t *section, float b0, float b1, float b2, float a1, float a2)
+{
+    int32_t qb0 = lroundf(b0 * (1 << BIQUAD_Q));
+    int32_t qb2 = lroundf(b2 * (1 << BIQUAD_Q));
+    int32_t qa1 = lroundf(a1 * (1 << BIQUAD_Q));
+    int32_t qa2 = lroundf(a2 * (1 << BIQUAD_Q));
+    float dcGain = (b0 + b1 + b2) / (1 + a1 + a2);
+    int32_t qb1 = lroundf(dcGain * ((1 << BIQUAD_Q) + qa1 + qa2)) - qb0 - qb2;
+
+    section->b0b1 = SIMD_PACK2(qb0, qb1);
+    section->b2a1 = SIMD_PACK2(qb2, -qa1);
+    section->a2 = -qa2;
+    biquadReset(section, 0);
+}
+
+
+//Notch at freqHz, q sets the width (centre frequency over -3 dB bandwidth)
+void
+biquadNotch (biquad_t *section, float freqHz, float q, float sampleHz)
+{
+    float w0 = 2 * PI_F * freqHz / sampleHz;
+    float alpha = sinf(w0) / (2 * q);
+    float a0 = 1 + alpha;
+
+    setCoefficients(section, 1 / a0, -2 * cosf(w0) / a0, 1 / a0,
+                    -2 * cosf(w0) / a0, (1 - alpha) / a0);
+}
+
+
+//Second order low pass with its corner at freqHz, q of 0.707 is Butterworth
+void
+biquadLowPass (biquad_t *section, float freqHz, float q, float sampleHz)
+{
+    float w0 = 2 * PI_F * freqHz / sampleHz;
+    float alpha = sinf(w0) / (2 * q);
+    float a0 = 1 + alpha;
+    float c = cosf(w0);
+
+    setCoefficients(section, (1 - c) / 2 / a0, (1 - c) / a0, (1 - c) / 2 / a0,
+                    -2 * c / a0, (1 - alpha) / a0);
+}
+
+
+//Settle the section at a steady input, avoids a start up transient from zero
+void
+biquadReset (biquad_t *section, int16_t value)
+{
+    section->x1 = value;
+    section->x2 = value;
+    section->y1 = value;
+    section->y2 = value;
+    section->residue = 0;
+}
+
+
+// *******************************************************
+// biquadCascade: Run one sample through each section in turn. Three dual MACs per section,
+// outputs are truncated with the dropped fraction carried to the next sample, and saturated
+// to int16 so leave headroom for notch overshoot.
+int16_t
+biquadCascade (biquad_t *sections, uint8_t count, int16_t sample)
+{
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        biquad_t *s = &sections[i];
+        int32_t acc = s->residue;
+
+        acc = SIMD_MAC2(SIMD_PACK2(sample, s->x1), s->b0b1, acc);
+        acc = SIMD_MAC2(SIMD_PACK2(s->x2, s->y1), s->b2a1, acc);
+        acc += s->y2 * s->a2;
+        s->residue = acc & ((1 << BIQUAD_Q) - 1);
+        acc >>= BIQUAD_Q;
+
+        if (acc > INT16_MAX) {
+            acc = INT16_MAX;
+        } else if (acc < INT16_MIN) {
+            acc = INT16_MIN;
+        }
+
+        s->x2 = s->x1;
+        s->x1 = sample;
+        s->y2 = s->y1;
+        s->y1 = acc;
+        sample = acc;
+    }
+    return sample;
+}
@@ -0,0 +1,43 @@
+/*
+ * biquad.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "simd.h"
+
+#define BIQUAD_Q 14     //Coefficient fraction bits, coefficients must lie within +-2
+
+
+#ifndef BIQUAD_H_
+#define BIQUAD_H_
+
+// *******************************************************
+// Fixed point direct form I biquad section. Samples and state are int16, coefficients
+// are Q14 and stored as pairs packed into words so that each section is three dual
+// 16 bit multiply-accumulates on the Cortex-M4:
+//   y = b0*x0 + b1*x1 + b2*x2 - a1*y1 - a2*y2
+// The fraction dropped from each output is fed into the next (first order error feedback).
+// Plain rounding leaves a low corner section a deadband of half an LSB over its DC gain
+// sum, tens of counts at 40 Hz, where it holds still off the input.
+typedef struct {
+    uint32_t b0b1;      //b1 in the top half, b0 in the bottom
+    uint32_t b2a1;      //-a1 in the top half, b2 in the bottom
+    int32_t a2;         //-a2
+    int16_t x1, x2;     //Previous inputs
+    int16_t y1, y2;     //Previous outputs
+    int32_t residue;    //Fraction dropped from the last output, Q14
+} biquad_t;
+
+void biquadNotch (biquad_t *section, float freqHz, float q, float sampleHz);
+
+void biquadLowPass (biquad_t *section, float freqHz, float q, float sampleHz);
+
+void biquadReset (biquad_t *section, int16_t value);
+
+int16_t biquadCascade (biquad_t *sections, uint8_t count, int16_t sample);
+
+#endif /* BIQUAD_H_ */
@@ -10,36 +10,41 @@
 // *******************************************************
 
 #include <stdint.h>
-#include "stdlib.h"
 #include "circBufT.h"
 
 // *******************************************************
 // initCircBuf: Initialise the circBuf instance. Reset both indices to
-// the start of the buffer.  Dynamically allocate and clear the the 
-// memory and return a pointer for the data.  Return NULL if 
-// allocation fails.
+// the start of the buffer.  The caller supplies statically allocated
+// storage of at least size entries, which is cleared and returned.
 uint32_t *
-initCircBuf (circBuf_t *buffer, uint32_t size)
+initCircBuf (circBuf_t *buffer, uint32_t *data, uint32_t size)
 {
+	uint32_t i;
+
 	buffer->windex = 0;
 	buffer->rindex = 0;
 	buffer->size = size;
-	buffer->data = 
-        (uint32_t *) calloc (size, sizeof(uint32_t));
+	buffer->data = data;
+	for (i = 0; i < size; i++)
+	   buffer->data[i] = 0;
 	return buffer->data;
 }
-   // Note use of calloc() to clear contents.
 
 // *******************************************************
 // writeCircBuf: insert entry at the current windex location,
-// advance windex, modulo (buffer size).
-void
+// advance windex, modulo (buffer size). Returns the entry that was
+// overwritten, the oldest one once the buffer has filled.
+uint32_t
 writeCircBuf (circBuf_t *buffer, uint32_t entry)
 {
+	uint32_t oldest;
+
+	oldest = buffer->data[buffer->windex];
 	buffer->data[buffer->windex] = entry;
 	buffer->windex++;
 	if (buffer->windex >= buffer->size)
 	   buffer->windex = 0;
+	return oldest;
 }
 
 // *******************************************************
@@ -59,16 +64,49 @@ readCircBuf (circBuf_t *buffer)
 }
 
 // *******************************************************
-// freeCircBuf: Releases the memory allocated to the buffer data,
-// sets pointer to NULL and ohter fields to 0. The buffer can
-// re-initialised by another call to initCircBuf().
-void
-freeCircBuf (circBuf_t * buffer)
+// initCircBuf16: As initCircBuf for a packed buffer. The caller supplies
+// CIRCBUF16_WORDS(size) words of statically allocated storage.
+uint32_t *
+initCircBuf16 (circBuf16_t *buffer, uint32_t *data, uint32_t size)
 {
+	uint32_t i;
+
 	buffer->windex = 0;
 	buffer->rindex = 0;
-	buffer->size = 0;
-	free (buffer->data);
-	buffer->data = NULL;
+	buffer->size = size;
+	buffer->data = data;
+	for (i = 0; i < CIRCBUF16_WORDS(size); i++)
+	   buffer->data[i] = 0;
+	return buffer->data;
+}
+
+// *******************************************************
+// writeCircBuf16: As writeCircBuf for a packed buffer.
+uint16_t
+writeCircBuf16 (circBuf16_t *buffer, uint16_t entry)
+{
+	uint32_t *word = &buffer->data[buffer->windex >> 1];
+	uint32_t shift = (buffer->windex & 1) << 4;
+	uint16_t oldest;
+
+	oldest = *word >> shift;
+	*word = (*word & ~(0xFFFFu << shift)) | ((uint32_t) entry << shift);
+	buffer->windex++;
+	if (buffer->windex >= buffer->size)
+	   buffer->windex = 0;
+	return oldest;
 }
 
+// *******************************************************
+// readCircBuf16: As readCircBuf for a packed buffer.
+uint16_t
+readCircBuf16 (circBuf16_t *buffer)
+{
+	uint16_t entry;
+
+	entry = buffer->data[buffer->rindex >> 1] >> ((buffer->rindex & 1) << 4);
+	buffer->rindex++;
+	if (buffer->rindex >= buffer->size)
+	   buffer->rindex = 0;
+	return entry;
+}
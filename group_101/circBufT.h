@@ -22,18 +22,30 @@ typedef struct {
 	uint32_t *data;		// pointer to the data
 } circBuf_t;
 
+// *******************************************************
+// Packed buffer of 16 bit entries, two to a word, entry i in the
+// bottom half of word i/2 when i is even. Entries must be below 0x8000.
+typedef struct {
+	uint32_t size;		// Number of entries in buffer
+	uint32_t windex;	// index for writing, mod(size)
+	uint32_t rindex;	// index for reading, mod(size)
+	uint32_t *data;		// pointer to (size + 1) / 2 words of data
+} circBuf16_t;
+
+#define CIRCBUF16_WORDS(size) (((size) + 1) / 2)
+
 // *******************************************************
 // initCircBuf: Initialise the circBuf instance. Reset both indices to
-// the start of the buffer.  Dynamically allocate and clear the the 
-// memory and return a pointer for the data.  Return NULL if 
-// allocation fails.
+// the start of the buffer.  The caller supplies statically allocated
+// storage of at least size entries, which is cleared and returned.
 uint32_t *
-initCircBuf (circBuf_t *buffer, uint32_t size);
+initCircBuf (circBuf_t *buffer, uint32_t *data, uint32_t size);
 
 // *******************************************************
 // writeCircBuf: insert entry at the current windex location,
-// advance windex, modulo (buffer size).
-void
+// advance windex, modulo (buffer size). Returns the entry that was
+// overwritten, the oldest one once the buffer has filled.
+uint32_t
 writeCircBuf (circBuf_t *buffer, uint32_t entry);
 
 // *******************************************************
@@ -44,10 +56,19 @@ uint32_t
 readCircBuf (circBuf_t *buffer);
 
 // *******************************************************
-// freeCircBuf: Releases the memory allocated to the buffer data,
-// sets pointer to NULL and other fields to 0. The buffer can
-// re initialised by another call to initCircBuf().
-void
-freeCircBuf (circBuf_t *buffer);
+// initCircBuf16: As initCircBuf for a packed buffer. The caller supplies
+// CIRCBUF16_WORDS(size) words of statically allocated storage.
+uint32_t *
+initCircBuf16 (circBuf16_t *buffer, uint32_t *data, uint32_t size);
+
+// *******************************************************
+// writeCircBuf16: As writeCircBuf for a packed buffer.
+uint16_t
+writeCircBuf16 (circBuf16_t *buffer, uint16_t entry);
+
+// *******************************************************
+// readCircBuf16: As readCircBuf for a packed buffer.
+uint16_t
+readCircBuf16 (circBuf16_t *buffer);
 
 #endif /*CIRCBUFT_H_*/
@@ -0,0 +1,36 @@
+/*
+ * coupling.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "coupling.h"
+
+#if COUPLING_DYNAMIC
+static float lag = 0;   //Modelled main rotor speed, as the duty it would settle at
+#endif
+
+
+// *******************************************************
+// couplingFeedForward: Tail duty that cancels the main rotor torque, called every controller
+// tick with the main duty applied on the last mix in DUTY_SCALE units, the duty the rotor
+// is really following. The rotor is stopped while not running, so the model restarts from
+// rest and the spin up kick is compensated.
+int32_t
+couplingFeedForward (int32_t mainDuty, bool running)
+{
+#if COUPLING_DYNAMIC
+    if (!running) {
+        lag = 0;
+        return 0;
+    }
+
+    float rate = (mainDuty - lag) / COUPLING_TAU;
+    lag += rate * DELTA_T;
+
+    return (int32_t) (KC * lag + COUPLING_KR * rate);
+#else
+    return 0;
+#endif
+}
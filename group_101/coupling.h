@@ -0,0 +1,30 @@
+/*
+ * coupling.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pwmRotor.h"
+
+//Main rotor reaction torque model, tail duty to cancel it is
+//  KC * lag + COUPLING_KR * d(lag)/dt, lag = main duty through a COUPLING_TAU first order lag
+//To identify, hold yaw on the tail PID and step the main duty: the settled tail duty change
+//over the main step is KC, the time to 63% of it is COUPLING_TAU, and the tail overshoot
+//area over the main step is COUPLING_KR.
+#define KC 0.8              //Steady state tail duty per main duty
+#define COUPLING_TAU 0.15   //Main rotor speed time constant, s
+#define COUPLING_KR 0.04    //Spin up torque, tail duty per main duty per second of change
+
+//Set to 0 for the static KC coupling in the mixer table only
+#define COUPLING_DYNAMIC 1
+
+
+#ifndef COUPLING_H_
+#define COUPLING_H_
+
+int32_t couplingFeedForward (int32_t mainDuty, bool running);
+
+#endif /* COUPLING_H_ */
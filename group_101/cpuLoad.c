@@ -0,0 +1,65 @@
+/*
+ * cpuLoad.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "cpuLoad.h"
+
+//SysTick counts spent asleep in the current window, only written with interrupts masked
+static volatile uint32_t idleCounts = 0;
+static volatile uint8_t cpuLoad = 0;   //Busy percentage of the last complete window
+
+
+// *******************************************************
+// cpuIdleSleep: Sleep until the next interrupt and add the time spent asleep to the idle count.
+// Must be called with interrupts masked so a task flag set just before WFI still wakes the CPU,
+// the pending ISR then runs once the caller re-enables interrupts.
+void
+cpuIdleSleep (void)
+{
+    uint32_t period = SysTickPeriodGet();
+    uint32_t start = SysTickValueGet();
+
+    SysCtlSleep();
+
+    //SysTick counts down and the SysTick interrupt always wakes us, so at most one reload has passed
+    uint32_t end = SysTickValueGet();
+    if (start >= end) {
+        idleCounts += start - end;
+    } else {
+        idleCounts += start + period - end;
+    }
+}
+
+
+// *******************************************************
+// cpuLoadTick: Called from the SysTick ISR, latches the busy percentage once per CPU_LOAD_WINDOW ticks
+void
+cpuLoadTick (void)
+{
+    static uint16_t windowCount = 0;
+
+    windowCount++;
+    if (windowCount >= CPU_LOAD_WINDOW) {
+        uint32_t windowCounts = SysTickPeriodGet() * CPU_LOAD_WINDOW;
+        uint32_t idlePercent = idleCounts / (windowCounts / 100);
+
+        if (idlePercent > 100) {
+            idlePercent = 100;
+        }
+        cpuLoad = 100 - idlePercent;
+
+        idleCounts = 0;
+        windowCount = 0;
+    }
+}
+
+
+//Get CPU utilisation of the last window as a percentage
+uint8_t
+getCpuLoad (void)
+{
+    return cpuLoad;
+}
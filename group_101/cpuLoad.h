@@ -0,0 +1,27 @@
+/*
+ * cpuLoad.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
+
+#define CPU_LOAD_WINDOW 1000    //SysTick ticks per utilisation sample, 1 s at 1 kHz
+
+
+#ifndef CPULOAD_H_
+#define CPULOAD_H_
+
+void cpuIdleSleep (void);
+
+void cpuLoadTick (void);
+
+uint8_t getCpuLoad (void);
+
+#endif /* CPULOAD_H_ */
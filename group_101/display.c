@@ -7,13 +7,15 @@
 
 #include "display.h"
 
+static char lineString[DISPLAY_LINE_LEN + 1];   //OLED line being formatted
+
 
 // *******************************************************
 // displayWrite: Updates the OLED display with altitude and yaw information based on the current display mode.
 // This function handles the formatting and output of altitude and yaw data onto an OLED display.
 // The display mode can be either PROCESSED, RAW, or DISPLAY_OFF, which affects what and how information is displayed.
 void 
-displayWrite(uint16_t baseAlt, uint16_t currentAlt, int32_t currentYaw, enum DisplayMode displayCycle) {
+displayWrite(uint16_t baseAlt, uint16_t currentAlt, angle_t currentYaw, enum DisplayMode displayCycle) {
 
     // Get Altitude as a percentage
     int32_t altPercentage = getAltPercent(baseAlt, currentAlt);
@@ -21,43 +23,25 @@ displayWrite(uint16_t baseAlt, uint16_t currentAlt, int32_t currentYaw, enum Dis
     // Get yaw as a degree
     int32_t yawDegree = getYawDegree(currentYaw);
 
-    //Create string instance
-    char lineString[17]; // 16 characters across the display
-
     switch (displayCycle) {
         case PROCESSED:
         {
-            //Special case when 0/100=0 and not -0 when Deg = -0.8
-            bool negZero = false;
+            char *p;
 
             //Title
             OLEDStringDraw ("helicopter Stats", 0, 0);
 
             // Display ADC input as a height percentage
-            usnprintf(lineString, sizeof(lineString), "Altitude: %3d%% ", altPercentage);
+            p = fmtStr(lineString, "Altitude: ");
+            p = fmtPercent(p, altPercentage, 3);
+            fmtStr(p, " ");
             OLEDStringDraw (lineString, 0, 1);
 
-            // Calculate Yaw decimal point using modulo
-            int32_t yawInt = yawDegree / SCALE_BY_100;
-            int32_t yawDecimal = yawDegree % SCALE_BY_100;
-
-            // Prevent the decimal portion from displaying as negative
-            if (yawDecimal < 0) {
-                yawDecimal *= -1;
-                negZero = true;
-            }
-
-            if (negZero && yawInt == 0) {
-                //Display a -ve zero as integer -ve 0 does not exist
-                usnprintf(lineString, sizeof(lineString), "Yaw(deg):-0.%d   ", yawDecimal);
-            } else {
-                //Display yaw in degrees to 2dp
-                usnprintf(lineString, sizeof(lineString), "Yaw(deg):%d.%d   ", yawInt, yawDecimal);
-            }
-            //Clear display line
+            //Display yaw in degrees to 2dp, right aligned to overwrite the previous value
+            p = fmtStr(lineString, "Yaw(deg):");
+            fmtFixed(p, yawDegree, 2, DISPLAY_LINE_LEN - (p - lineString));
             OLEDStringDraw (lineString, 0, 2);
 
-            negZero = false;
             break;
         }
         case RAW:
@@ -65,7 +49,9 @@ displayWrite(uint16_t baseAlt, uint16_t currentAlt, int32_t currentYaw, enum Dis
             OLEDStringDraw ("Helicopter Stats", 0, 0);
 
             // Display the mean ADC value
-            usnprintf(lineString, sizeof(lineString), "Mean ADC: %4d ", currentAlt);
+            char *p = fmtStr(lineString, "Mean ADC: ");
+            p = fmtInt(p, currentAlt, 4);
+            fmtStr(p, " ");
             OLEDStringDraw (lineString, 0, 1);
             //Clear Yaw line
             OLEDStringDraw ("                ", 0, 2);
@@ -99,11 +85,11 @@ getAltPercent (uint16_t baseAltitude, int32_t altitude)
 }
 
 // *******************************************************
-// getYawDegree: Scale by 100 before division to include 2 decimal point for modulo division
+// getYawDegree: Yaw in hundredths of a degree, -180.00 to 180.00
 int32_t 
-getYawDegree(int32_t currentYaw)
+getYawDegree(angle_t currentYaw)
 {   
-    return (currentYaw * DEG_REV * SCALE_BY_100) / YAW_STEPS; 
+    return angleToCentiDeg(currentYaw);
 }
 
 
@@ -20,12 +20,13 @@
 #include "utils/ustdlib.h"
 #include "OrbitOLED/OrbitOLEDInterface.h"
 #include "OrbitOLED/lib_OrbitOled/OrbitOled.h"
+#include "memPlan.h"
+#include "fastFmt.h"
+#include "yawAngle.h"
 
 
 //Global constants
 #define ADC_STEP_FOR_1V 1240
-#define YAW_STEPS 448
-#define DEG_REV 360
 #define SCALE_BY_100 100
 
 //Display mode enum
@@ -36,11 +37,11 @@ enum DisplayMode { PROCESSED, RAW, DISPLAY_OFF, CYCLE_BACK};
 
 
 
-void displayWrite(uint16_t baseAlt, uint16_t currentAlt, int32_t currentYaw, enum DisplayMode displayCycle);
+void displayWrite(uint16_t baseAlt, uint16_t currentAlt, angle_t currentYaw, enum DisplayMode displayCycle);
 
 int32_t getAltPercent (uint16_t baseAltitude, int32_t altitude);
 
-int32_t getYawDegree(int32_t currentYaw);
+int32_t getYawDegree(angle_t currentYaw);
 
 void initDisplay (void);
 
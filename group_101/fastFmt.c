@@ -0,0 +1,111 @@
+/*
+ * fastFmt.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "fastFmt.h"
+
+
+// *******************************************************
+// fmtField: Write sign and reversed digits right aligned in width, returns the terminator
+static char *
+fmtField (char *dst, const char *rev, uint8_t len, bool neg, uint8_t width)
+{
+    uint8_t total = len + (neg ? 1 : 0);
+
+    while (width > total) {
+        *dst++ = ' ';
+        width--;
+    }
+    if (neg) {
+        *dst++ = '-';
+    }
+    while (len > 0) {
+        *dst++ = rev[--len];
+    }
+    *dst = '\0';
+    return dst;
+}
+
+
+//Copy a string, returns the terminator
+char *
+fmtStr (char *dst, const char *src)
+{
+    while (*src) {
+        *dst++ = *src++;
+    }
+    *dst = '\0';
+    return dst;
+}
+
+
+//Signed decimal integer
+char *
+fmtInt (char *dst, int32_t value, uint8_t width)
+{
+    return fmtFixed(dst, value, 0, width);
+}
+
+
+// *******************************************************
+// fmtFixed: Signed fixed-point value scaled by 10^decimals, e.g. 12345 with 2 decimals is
+// "123.45" and -5 is "-0.05". The fraction is always zero padded to decimals digits.
+char *
+fmtFixed (char *dst, int32_t value, uint8_t decimals, uint8_t width)
+{
+    char rev[FMT_MAX_FIELD];
+    uint8_t len = 0;
+    uint8_t minLen = decimals ? decimals + 2 : 1;   //At least one integer digit
+    bool neg = value < 0;
+    uint32_t mag = neg ? -(uint32_t) value : (uint32_t) value;
+
+    //Build digits least significant first, inserting the point after the fraction
+    do {
+        rev[len++] = '0' + mag % 10;
+        mag /= 10;
+        if (len == decimals) {
+            rev[len++] = '.';
+        }
+    } while (mag > 0 || len < minLen);
+
+    return fmtField(dst, rev, len, neg, width);
+}
+
+
+//Signed integer followed by a percent sign, width excludes the percent sign
+char *
+fmtPercent (char *dst, int32_t value, uint8_t width)
+{
+    dst = fmtInt(dst, value, width);
+    *dst++ = '%';
+    *dst = '\0';
+    return dst;
+}
+
+
+//Parse an optionally signed decimal after any spaces, returns NULL if there are no digits
+const char *
+parseInt (const char *s, int32_t *value)
+{
+    bool neg = false;
+    int32_t v = 0;
+
+    while (*s == ' ') {
+        s++;
+    }
+    if (*s == '-') {
+        neg = true;
+        s++;
+    }
+    if (*s < '0' || *s > '9') {
+        return 0;
+    }
+    while (*s >= '0' && *s <= '9') {
+        v = v * 10 + (*s++ - '0');
+    }
+    *value = neg ? -v : v;
+    return s;
+}
@@ -0,0 +1,34 @@
+/*
+ * fastFmt.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Longest field any formatter writes, sign plus 10 digits plus decimal point
+#define FMT_MAX_FIELD 12
+
+
+#ifndef FASTFMT_H_
+#define FASTFMT_H_
+
+// *******************************************************
+// Allocation-free formatters for telemetry and OLED text. Each writes into the
+// caller's buffer, NUL terminates it and returns a pointer to the terminator so
+// calls can be chained to build a line. Fields narrower than width are right
+// aligned with spaces, width 0 means no padding. The caller sizes the buffer.
+char *fmtStr (char *dst, const char *src);
+
+char *fmtInt (char *dst, int32_t value, uint8_t width);
+
+char *fmtFixed (char *dst, int32_t value, uint8_t decimals, uint8_t width);
+
+char *fmtPercent (char *dst, int32_t value, uint8_t width);
+
+//Parse a decimal from a command line, returns a pointer past it or NULL if there is none
+const char *parseInt (const char *s, int32_t *value);
+
+#endif /* FASTFMT_H_ */
@@ -0,0 +1,162 @@
+/*
+ * health.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "health.h"
+
+static uint8_t faults = 0;          //Latched healthFault bits, cleared only by reset
+static uint16_t faultCount = 0;     //Number of distinct faults raised
+
+//Check state
+static bool primed = false;
+static uint16_t prevAlt = 0;
+static uint32_t prevTick = 0;
+static uint32_t prevRawChanges = 0;
+static angle_t prevYaw = 0;
+static uint16_t altRateTicks = 0;
+static uint16_t altStuckTicks = 0;
+static uint16_t yawStuckTicks = 0;
+
+//Failsafe descent state
+static bool descending = false;
+static int32_t descentThrust = 0;   //Scaled by HEALTH_DESCENT_TICKS
+static uint16_t descentHold = 0;
+
+
+//Latch a fault, counting it the first time it is seen
+static void
+raiseFault (uint8_t fault)
+{
+    if (!(faults & fault)) {
+        faults |= fault;
+        faultCount++;
+    }
+}
+
+
+// *******************************************************
+// healthCheck: Range, rate of change, stuck value and encoder activity checks, called every
+// controller tick. The rate limit scales with the SysTick time since the last check so a
+// late tick does not read as a jump. Stuck and activity checks only run airborne since a
+// landed heli is still.
+void
+healthCheck (uint16_t alt, angle_t yaw, bool airborne)
+{
+    uint32_t tick = getSensorTick();
+    uint32_t rawChanges = getAltRawChanges();
+
+    if (!primed) {
+        prevAlt = alt;
+        prevTick = tick - 1;
+        prevRawChanges = rawChanges;
+        prevYaw = yaw;
+        primed = true;
+    }
+
+    int32_t altChange = (int32_t) alt - prevAlt;
+    int32_t altChangeMax = HEALTH_ALT_RATE_MAX * (int32_t) (tick - prevTick);
+
+    //Range, the sensor is railed or the heli is well outside its travel
+    if (alt < HEALTH_ADC_MIN || alt > HEALTH_ADC_MAX ||
+        (getmin_alt() != 0 && (alt > getmin_alt() + HEALTH_ALT_MARGIN ||
+                               alt < getmax_alt() - HEALTH_ALT_MARGIN))) {
+        raiseFault(FAULT_ALT_RANGE);
+    }
+
+    //Rate of change, the mean of BUF_SIZE samples cannot jump this fast for long
+    if (altChange > altChangeMax || altChange < -altChangeMax) {
+        if (++altRateTicks >= HEALTH_ALT_RATE_TICKS) {
+            raiseFault(FAULT_ALT_RATE);
+        }
+    } else {
+        altRateTicks = 0;
+    }
+
+    if (airborne) {
+        //Stuck value, a live sensor always shows some noise in its raw samples. The mean is
+        //filtered too heavily to tell, it can hold still on a live sensor
+        if (rawChanges == prevRawChanges) {
+            if (++altStuckTicks >= HEALTH_ALT_STUCK_TICKS) {
+                raiseFault(FAULT_ALT_STUCK);
+            }
+        } else {
+            altStuckTicks = 0;
+        }
+
+        //Encoder activity, the tail is being driven hard but no edges arrive
+        int32_t yawErr = angleToCounts(getYawSet() - yaw);
+        if (yaw == prevYaw && (yawErr > HEALTH_YAW_ERR_COUNTS || yawErr < -HEALTH_YAW_ERR_COUNTS)) {
+            if (++yawStuckTicks >= HEALTH_YAW_STUCK_TICKS) {
+                raiseFault(FAULT_YAW_STUCK);
+            }
+        } else {
+            yawStuckTicks = 0;
+        }
+    } else {
+        altStuckTicks = 0;
+        yawStuckTicks = 0;
+    }
+
+    prevAlt = alt;
+    prevTick = tick;
+    prevRawChanges = rawChanges;
+    prevYaw = yaw;
+}
+
+
+// *******************************************************
+// healthLimitThrust: Pass the thrust command through unless altitude has faulted, then ramp
+// it open loop from at most hover down to PWM_DUTY_MAIN_MIN so the heli settles onto the rig
+int32_t
+healthLimitThrust (int32_t thrust)
+{
+    if (!(faults & FAULT_ALT_MASK)) {
+        return thrust;
+    }
+
+    //Thrust command that puts the main rotor at minimum duty
+    int32_t floor = DUTY_PERCENT(PWM_DUTY_MAIN_MIN) - getMixerOffset(ACT_MAIN);
+
+    if (!descending) {
+        descending = true;
+        descentThrust = (thrust < 0 ? thrust : 0) * HEALTH_DESCENT_TICKS;
+    }
+
+    int32_t step = -floor;
+    if (descentThrust > floor * HEALTH_DESCENT_TICKS + step) {
+        descentThrust -= step;
+    } else {
+        descentThrust = floor * HEALTH_DESCENT_TICKS;
+        if (descentHold < HEALTH_DESCENT_HOLD) {
+            descentHold++;
+        }
+    }
+    return descentThrust / HEALTH_DESCENT_TICKS;
+}
+
+
+//True once the open loop descent has reached and held minimum duty
+bool
+healthDescentDone (void)
+{
+    return descentHold >= HEALTH_DESCENT_HOLD;
+}
+
+
+//Get latched fault bits
+uint8_t
+getHealthFaults (void)
+{
+    return faults;
+}
+
+
+//Get number of faults raised since reset
+uint16_t
+getFaultCount (void)
+{
+    return faultCount;
+}
@@ -0,0 +1,55 @@
+/*
+ * health.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "yawAngle.h"
+#include "pwmRotor.h"
+#include "mixer.h"
+#include "ADC.h"
+#include "sensorState.h"
+
+//Altitude checks, ADC counts, run every controller tick
+#define HEALTH_ADC_MIN 20           //Readings this close to the ADC rails mean a saturated sensor
+#define HEALTH_ADC_MAX 4075
+#define HEALTH_ALT_MARGIN 248       //20%, allowed beyond the 0-100% altitude window
+#define HEALTH_ALT_RATE_MAX 15      //Largest believable change in mean altitude per SysTick ms
+#define HEALTH_ALT_RATE_TICKS 3     //Consecutive over-rate checks before a fault
+#define HEALTH_ALT_STUCK_TICKS 500  //2 s without any change in the raw samples while airborne
+
+//Encoder check, no yaw edges for this long while the yaw error is this large
+#define HEALTH_YAW_STUCK_TICKS 125  //0.5 s
+#define HEALTH_YAW_ERR_COUNTS 20
+
+//Open loop descent used when altitude can no longer be trusted
+#define HEALTH_DESCENT_TICKS 1000   //4 s from hover duty down to PWM_DUTY_MAIN_MIN
+#define HEALTH_DESCENT_HOLD 250     //Hold at minimum duty before switching off
+
+
+#ifndef HEALTH_H_
+#define HEALTH_H_
+
+//Latched fault bits
+enum healthFault {
+    FAULT_ALT_RANGE = 0x01,
+    FAULT_ALT_RATE  = 0x02,
+    FAULT_ALT_STUCK = 0x04,
+    FAULT_YAW_STUCK = 0x08
+};
+#define FAULT_ALT_MASK (FAULT_ALT_RANGE | FAULT_ALT_RATE | FAULT_ALT_STUCK)
+
+void healthCheck (uint16_t alt, angle_t yaw, bool airborne);
+
+int32_t healthLimitThrust (int32_t thrust);
+
+bool healthDescentDone (void);
+
+uint8_t getHealthFaults (void);
+
+uint16_t getFaultCount (void);
+
+#endif /* HEALTH_H_ */
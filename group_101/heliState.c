@@ -10,7 +10,21 @@
 // Initialize state
 static HelicopterState heliState = LANDED; //Helicopters state instance
 static bool landedLock = true;  //Start locked in landed mode until Switch1 pulled LOW
-bool scanFlag = true;           //Start in yaw scanning mode to locate physical yaw reference point
+volatile bool scanFlag = true;  //Start in yaw scanning mode to locate physical yaw reference point
+static volatile angle_t refPosition = 0;  //Yaw where the reference fired, counted from power on
+static bool refFound = false;             //Takeoff found the reference, save it on landing
+
+//Reference sweep state
+static bool sweepStarted = false;
+static int32_t sweepDir = 1;        //+1 clockwise, -1 counter-clockwise
+static angle_t sweepSetPoint = 0;
+static uint32_t sweepTick = 0;
+
+//Takeoff timing, SysTick ticks are ms
+static uint32_t takeoffStartTick = 0;
+static uint32_t takeoffTime = 0;
+static uint32_t flyingStartTick = 0;
+static uint16_t takeoffOvershoot = 0;   //ADC counts above the takeoff altitude
 
 // Corresponding array of strings for helicopter state enum
 static char 
@@ -76,6 +90,7 @@ void
 yawRefHandler (void) {
     //Scan flag on by default
     if (scanFlag) {
+        refPosition = getYawPosition();
         setYawZero();
         setYaw(0);
         scanFlag = false;
@@ -89,38 +104,77 @@ yawRefHandler (void) {
 
 
 
-//Pole UP DN LF RT buttons for heli control
-void
+//Pole UP DN LF RT buttons for heli control, returns true if any was pushed
+bool
 poleButtons(void) {
+    bool pushed = false;
 
     updateButtons();
 
     // Left button decreases Yaw
     if (checkButton(LEFT) == PUSHED) {
         decYaw();
+        pushed = true;
     }
 
     // Right button decreases Yaw
     if (checkButton(RIGHT) == PUSHED) {
         incYaw();
+        pushed = true;
     }
 
     // Right button decreases Yaw
     if (checkButton(UP) == PUSHED) {
         incAlt();
+        pushed = true;
     }
 
     // Right button decreases Yaw
     if (checkButton(DOWN) == PUSHED) {
         decAlt();
+        pushed = true;
     }
+    return pushed;
 }
 
+//Record the highest the heli has risen above the takeoff altitude, ADC falls as height rises
+static void
+trackOvershoot (uint16_t altitude)
+{
+    int32_t over = (getmin_alt() - ALT_TAKEOFF_5_PERCENT) - altitude;
+
+    if (over > takeoffOvershoot) {
+        takeoffOvershoot = over;
+    }
+}
+
+
+//Remember where the reference was found for the next power on, once per boot and only if it
+//moved. persistWrite() blocks on the EEPROM so this is left until the rotors are off in LANDED.
+static void
+saveYawRef (void)
+{
+    static bool saved = false;
+    uint32_t lastRef;
+
+    if (refFound && !saved) {
+        int32_t moved = YAW_LIMIT;
+        if (persistRead(PERSIST_YAW_REF, &lastRef)) {
+            moved = angleToCounts(lastRef - refPosition);
+        }
+        if (moved >= YAW_LIMIT || moved <= -YAW_LIMIT) {
+            persistWrite(PERSIST_YAW_REF, refPosition);
+        }
+        saved = true;
+    }
+}
+
+
 /********************************************************
  * Function to set the Helicopter states
  ********************************************************/
 HelicopterState 
-updateHelicopterState(int32_t currentYaw, uint16_t currentAlt) {
+updateHelicopterState(angle_t currentYaw, uint16_t currentAlt) {
     bool sw1High = readSwitchState();
 
     switch (heliState) {
@@ -129,8 +183,13 @@ updateHelicopterState(int32_t currentYaw, uint16_t currentAlt) {
             if (!sw1High) {
                 landedLock = false;
             }
-            //Keep heli off when in LANDED
-            if (!landedLock && sw1High) {
+            //Keep heli off when in LANDED, and grounded once a sensor has faulted
+            if (!landedLock && sw1High && !getHealthFaults()) {
+                takeoffStartTick = getSensorTick();
+                takeoffOvershoot = 0;
+                sweepStarted = false;
+                controllerReset();
+                setAltGains(ALT_GAINS_TAKEOFF);
                 heliState = TAKING_OFF;
             } else {
                 PWM_OFF();
@@ -142,24 +201,63 @@ updateHelicopterState(int32_t currentYaw, uint16_t currentAlt) {
             // Activate motors to take off
             // Transition to FLYING after successful takeoff
             PWM_ON();
+            trackOvershoot(currentAlt);
             if (takeoffComplete(currentYaw, currentAlt)) {
+                takeoffTime = getSensorTick() - takeoffStartTick;
+                flyingStartTick = getSensorTick();
+                setAltGains(ALT_GAINS_FLIGHT);
                 heliState = FLYING;
             }
+            //Failsafe landing on a sensor fault
+            if (getHealthFaults()) {
+                setAltGains(ALT_GAINS_FLIGHT);
+                heliState = LANDING;
+            }
             break;
 
         case FLYING:
-            //Allow full user heli control after take off
-            poleButtons();
-            if (!sw1High) {
+            if (getSensorTick() - flyingStartTick < TAKEOFF_SETTLE_MS) {
+                trackOvershoot(currentAlt);
+            }
+            //Allow full user heli control after take off, any button takes over from a mission
+            if (poleButtons()) {
+                missionAbort();
+                sysidAbort();
+            }
+            //Missions and system identification runs take turns
+            if (!sysidRunning()) {
+                missionStartIfArmed();
+            }
+            if (!missionRunning()) {
+                sysidStartIfArmed();
+            }
+            missionUpdate(currentYaw, currentAlt);
+            //Land on request or as a failsafe on a sensor fault
+            if (!sw1High || getHealthFaults()) {
+                missionAbort();
+                sysidAbort();
                 heliState = LANDING;
             }
             break;
 
         case LANDING:
-            // Set yaw to 0 to land on yaw ref point
-            setYaw(0);
-            // Remain in LANDING until landing is complete
-            if (landingComplete(currentYaw, currentAlt)) {
+            // Set yaw to 0 to land on yaw ref point, unless the encoder has failed
+            if (!(getHealthFaults() & FAULT_YAW_STUCK)) {
+                setYaw(0);
+            }
+            // Remain in LANDING until landing is complete, altitude cannot be trusted
+            // after an altitude fault so wait for the open loop descent instead
+            if (getHealthFaults() & FAULT_ALT_MASK) {
+                if (healthDescentDone()) {
+                    controllerReset();
+                    saveYawRef();
+                    heliState = LANDED;
+                }
+            } else if (landingComplete(currentYaw, currentAlt)) {
+                //Keep the hover duty learnt this flight for the next takeoff
+                hoverSave();
+                saveYawRef();
+                controllerReset();
                 heliState = LANDED;
             }
             break;
@@ -169,12 +267,13 @@ updateHelicopterState(int32_t currentYaw, uint16_t currentAlt) {
 
 //Auto landing function, yaw set to zero then wait for altitude to decrease to 0-2% then turn off PWM
 bool 
-landingComplete(int32_t yaw, uint16_t altitude) {
+landingComplete(angle_t yaw, uint16_t altitude) {
     // Logic to check if landing is complete
     uint16_t minAlt = getmin_alt();
+    int32_t yawCounts = angleToCounts(yaw);
 
-    //Wait for yaw to go to zero
-    if (yaw >= -YAW_LIMIT && yaw < YAW_LIMIT) {
+    //Wait for yaw to go to zero, skipped if the encoder has failed
+    if ((yawCounts >= -YAW_LIMIT && yawCounts < YAW_LIMIT) || (getHealthFaults() & FAULT_YAW_STUCK)) {
         setAlt(minAlt); //Set altitude to 0%
         //Wait for altitude to go <2%
         if (altitude <= minAlt && altitude >= minAlt - ALT_LAND) {
@@ -191,9 +290,44 @@ landingComplete(int32_t yaw, uint16_t altitude) {
 }
 
 
-//Auto take off to 5% then rotate clockwise a full rev to find yaw reference point
+// *******************************************************
+// sweepYaw: Turn towards where the reference was last found, or clockwise if it has never been
+// found, ramping the setpoint at YAW_SWEEP_RATE_DEG but never more than YAW_SWEEP_LEAD_DEG
+// ahead of the heli. Carries on in the same direction if the reference has moved.
+static void
+sweepYaw (angle_t yaw)
+{
+    uint32_t now = getSensorTick();
+    uint32_t lastRef;
+
+    if (!sweepStarted) {
+        sweepDir = 1;
+        if (persistRead(PERSIST_YAW_REF, &lastRef) && (int32_t) (lastRef - yaw) < 0) {
+            sweepDir = -1;
+        }
+        sweepSetPoint = yaw;
+        sweepTick = now;
+        sweepStarted = true;
+    }
+
+    int32_t step = (now - sweepTick) * YAW_SWEEP_RATE_DEG * (ANGLE_PER_DEG / 1000);
+    int32_t lead = (int32_t) (sweepSetPoint + sweepDir * step - yaw);
+    int32_t maxLead = ANGLE_FROM_DEG(YAW_SWEEP_LEAD_DEG);
+
+    if (lead > maxLead) {
+        lead = maxLead;
+    } else if (lead < -maxLead) {
+        lead = -maxLead;
+    }
+    sweepSetPoint = yaw + lead;
+    sweepTick = now;
+    setYaw(sweepSetPoint);
+}
+
+
+//Auto take off to 5% then sweep yaw until the yaw reference point is found
 bool 
-takeoffComplete (int32_t yaw, uint16_t altitude) {
+takeoffComplete (angle_t yaw, uint16_t altitude) {
     uint16_t minAlt = getmin_alt();
 
     setAlt(minAlt - ALT_TAKEOFF_5_PERCENT);
@@ -202,11 +336,13 @@ takeoffComplete (int32_t yaw, uint16_t altitude) {
         //scanFlag changed by yaw ref point interupt
         //Wait to pass over yaw ref point
         if (!scanFlag) {
+            //Reassert in case the reference fired while the sweep setpoint was being written
+            setYaw(0);
+            refFound = true;
             return true;
         }
         else {
-            //Do full revolution
-            setYaw(223);
+            sweepYaw(yaw);
             return false;
         }
 
@@ -222,3 +358,21 @@ char*
 getHeliState (void) {
     return HELISTATE_STRING[heliState];
 }
+
+//Return heliState
+HelicopterState
+getHelicopterState (void) {
+    return heliState;
+}
+
+//Return time from leaving LANDED to reaching FLYING on the last takeoff in ms
+uint32_t
+getTakeoffTime (void) {
+    return takeoffTime;
+}
+
+//Return how far the last takeoff overshot the takeoff altitude in tenths of a percent
+uint16_t
+getTakeoffOvershoot (void) {
+    return (uint32_t) takeoffOvershoot * 1000 / ADC_STEP_FOR_1V;
+}
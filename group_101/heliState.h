@@ -16,6 +16,11 @@
 #include "pwmRotor.h"
 #include "buttons4.h"
 #include "quadrature.h"
+#include "mission.h"
+#include "persist.h"
+#include "health.h"
+#include "hover.h"
+#include "sysid.h"
 
 // Define states for the helicopter
 typedef enum {
@@ -25,6 +30,8 @@ typedef enum {
     LANDING
 } HelicopterState;
 
+#define TAKEOFF_SETTLE_MS 3000   //Overshoot is measured up to this long after reaching FLYING
+
 
 #ifndef HELISTATE_H_
 #define HELISTATE_H_
@@ -41,14 +48,20 @@ bool readSwitchState(void);
 
 void yawRefHandler (void);
 
-void poleButtons(void);
+bool poleButtons(void);
 
-HelicopterState updateHelicopterState(int32_t currentYaw, uint16_t currentAlt);
+HelicopterState updateHelicopterState(angle_t currentYaw, uint16_t currentAlt);
 
 char* getHeliState (void);
 
-bool landingComplete(int32_t yaw, uint16_t altitude);
+HelicopterState getHelicopterState (void);
+
+uint32_t getTakeoffTime (void);
+
+uint16_t getTakeoffOvershoot (void);
+
+bool landingComplete(angle_t yaw, uint16_t altitude);
 
-bool takeoffComplete (int32_t yaw, uint16_t altitude);
+bool takeoffComplete (angle_t yaw, uint16_t altitude);
 
 #endif /* HELISTATE_H_ */
@@ -0,0 +1,98 @@
+/*
+ * hover.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "hover.h"
+
+static int32_t hoverEstimate = 0;   //DUTY_SCALE units, HOVER_FRAC_BITS fraction bits
+static int32_t hoverSaved = 0;      //Last value written to EEPROM, DUTY_SCALE units
+static uint16_t steadyTicks = 0;
+static uint16_t prevAlt = 0;
+
+
+//Apply the estimate as the main rotor hover offset, and to the static tail coupling if in use
+static void
+applyHover (void)
+{
+    int32_t hover = hoverEstimate >> HOVER_FRAC_BITS;
+
+    mixerSetOffset(ACT_MAIN, hover);
+#if !COUPLING_DYNAMIC
+    mixerSetOffset(ACT_TAIL, KC * hover);
+#endif
+}
+
+
+// *******************************************************
+// initHover: Warm start from the hover duty learnt on previous flights, or GRAVITY if none
+// has been stored yet. Call after initPersist().
+void
+initHover (void)
+{
+    uint32_t stored;
+
+    hoverSaved = DUTY_PERCENT(GRAVITY);
+    if (persistRead(PERSIST_HOVER_DUTY, &stored) &&
+        stored >= DUTY_PERCENT(HOVER_MIN) && stored <= DUTY_PERCENT(HOVER_MAX)) {
+        hoverSaved = stored;
+    }
+    hoverEstimate = hoverSaved << HOVER_FRAC_BITS;
+    applyHover();
+}
+
+
+// *******************************************************
+// hoverUpdate: Called every controller tick with the main duty just applied. Once the heli
+// has held its altitude setpoint for HOVER_STEADY_TICKS that duty is what it takes to hover,
+// so the estimate moves towards it.
+void
+hoverUpdate (uint16_t alt, int32_t mainDuty, bool flying)
+{
+    int32_t rate = alt - prevAlt;
+    int32_t error = getAltSet() - alt;
+
+    prevAlt = alt;
+
+    if (!flying || rate > HOVER_STEADY_RATE || rate < -HOVER_STEADY_RATE ||
+        error > HOVER_STEADY_ERR || error < -HOVER_STEADY_ERR) {
+        steadyTicks = 0;
+        return;
+    }
+    if (steadyTicks < HOVER_STEADY_TICKS) {
+        steadyTicks++;
+        return;
+    }
+
+    hoverEstimate += ((mainDuty << HOVER_FRAC_BITS) - hoverEstimate) >> HOVER_GAIN_SHIFT;
+
+    if (hoverEstimate < DUTY_PERCENT(HOVER_MIN) << HOVER_FRAC_BITS) {
+        hoverEstimate = DUTY_PERCENT(HOVER_MIN) << HOVER_FRAC_BITS;
+    } else if (hoverEstimate > DUTY_PERCENT(HOVER_MAX) << HOVER_FRAC_BITS) {
+        hoverEstimate = DUTY_PERCENT(HOVER_MAX) << HOVER_FRAC_BITS;
+    }
+    applyHover();
+}
+
+
+//Store the learnt hover duty for the next flight, called on landing
+void
+hoverSave (void)
+{
+    int32_t hover = hoverEstimate >> HOVER_FRAC_BITS;
+
+    if (hover - hoverSaved >= HOVER_SAVE_DELTA || hoverSaved - hover >= HOVER_SAVE_DELTA) {
+        persistWrite(PERSIST_HOVER_DUTY, hover);
+        hoverSaved = hover;
+    }
+}
+
+
+//Get the hover duty estimate in DUTY_SCALE units
+int32_t
+getHoverDuty (void)
+{
+    return hoverEstimate >> HOVER_FRAC_BITS;
+}
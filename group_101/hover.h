@@ -0,0 +1,36 @@
+/*
+ * hover.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pwmRotor.h"
+#include "mixer.h"
+#include "persist.h"
+
+//Hover duty estimate, a recursive mean of the main duty over steady flight
+#define HOVER_GAIN_SHIFT 11         //Forgetting factor 1 - 2^-11, ~8 s at 250 Hz
+#define HOVER_FRAC_BITS 12          //Fraction bits kept on the DUTY_SCALE estimate
+#define HOVER_STEADY_RATE 2         //Largest change in mean altitude per tick counted as steady
+#define HOVER_STEADY_ERR 31         //2.5%, largest altitude error counted as steady
+#define HOVER_STEADY_TICKS 250      //1 s steady before the estimate adapts
+#define HOVER_MIN 20                //Bounds on the estimate, percent duty
+#define HOVER_MAX 50
+#define HOVER_SAVE_DELTA 50         //Only rewrite EEPROM once the estimate moves 0.5%
+
+
+#ifndef HOVER_H_
+#define HOVER_H_
+
+void initHover (void);
+
+void hoverUpdate (uint16_t alt, int32_t mainDuty, bool flying);
+
+void hoverSave (void);
+
+int32_t getHoverDuty (void);
+
+#endif /* HOVER_H_ */
@@ -28,6 +28,16 @@
 #include "pwmRotor.h"
 #include "uart.h"
 #include "heliState.h"
+#include "cpuLoad.h"
+#include "stackMon.h"
+#include "fastFmt.h"
+#include "sensorState.h"
+#include "mission.h"
+#include "health.h"
+#include "mixer.h"
+#include "hover.h"
+#include "sysid.h"
+#include "supervisor.h"
 
 
 //Task flags
@@ -40,7 +50,8 @@ static volatile bool flagUART = false;
 // Global variables
 //********************************************************
 
-char statusStr[MAX_STR_LEN + 1];
+static char statusStr[MAX_STR_LEN + 1];
+static char commandStr[UART_RX_LEN + 1];
 
 #define CONTROL_PERIOD 4    //Corrosponds to 250Hz
 #define BUTTON_PERIOD 10    //Corrosponds to 100Hz
@@ -48,6 +59,19 @@ char statusStr[MAX_STR_LEN + 1];
 #define UART_PERIOD 200     //Corrosponds to 5Hz
 #define START_DELAY 5       //200 ms delay
 
+//9600 baud carries ~190 characters per UART_PERIOD. The position and duty lines go every
+//update and the rest take turns, one per update, with a finished mission segment first.
+enum telemetryExtra {
+    TELEM_CPU = 0,
+    TELEM_FLIGHT,
+    TELEM_PWM,
+    TELEM_STACK,
+#if ALT_MPC
+    TELEM_MPC,
+#endif
+    NUM_TELEM_EXTRA
+};
+
 
 
 //*****************************************************************************
@@ -86,12 +110,6 @@ SysTickIntHandler(void)
     static uint8_t displayCounter = 0;
     static uint8_t uartCounter = 0;
 
-    //
-    // Initiate a conversion
-    //
-    ADCProcessorTrigger(ADC0_BASE, 3);
-
-
     //Set task flags based on desired task frequency
     if (controllerCounter >= CONTROL_PERIOD) {
         flagController = true;
@@ -118,6 +136,175 @@ SysTickIntHandler(void)
     buttonsCounter++;
     displayCounter++;
     uartCounter++;
+
+#if YAW_RATE_LOOP
+    //Yaw rate inner loop, the tail follows it between controller ticks. Duty latches once a
+    //PWM period so most of these are overwritten, the latest one is always the one applied.
+    int32_t remixDuty[NUM_ACTUATORS];
+    int32_t yawCut;
+
+    yawRateUpdate();
+    if (mixerRemix(AXIS_YAW, controllerTailRate(getYawRate()), remixDuty, &yawCut)) {
+        setDuty(remixDuty[ACT_MAIN], remixDuty[ACT_TAIL]);
+        controllerTailTrack(yawCut);
+    }
+#endif
+
+    //Close off the CPU utilisation window
+    cpuLoadTick();
+
+    //Advance sensor snapshot timestamps
+    sensorTick();
+
+    //Feed the watchdog if every task is keeping up
+    supervisorTick();
+}
+
+
+//*****************************************************************************
+// Send the cause of a watchdog reset, and which tasks had missed their deadlines
+//*****************************************************************************
+void
+reportBootReason (void)
+{
+    uint8_t i;
+
+    if (!getBootWatchdogReset()) {
+        return;
+    }
+
+    char *p = fmtStr(statusStr, "Watchdog reset, missed:");
+    for (i = 0; i < NUM_SUP_TASKS; i++) {
+        if (getBootMissedTasks() & (1 << i)) {
+            p = fmtStr(p, " ");
+            p = fmtStr(p, getSupTaskName(i));
+        }
+    }
+    if (getBootMissedTasks() == 0) {
+        p = fmtStr(p, " unknown");
+    }
+    fmtStr(p, "\r\n");
+    UARTSend (statusStr);
+}
+
+
+//*****************************************************************************
+// Send the next few lines of a requested system identification log, false if none
+//*****************************************************************************
+bool
+sendSysidLog (void)
+{
+    uint16_t logIndex;
+    sysidSample_t sample;
+    uint8_t line;
+    char *p;
+
+    for (line = 0; line < SYSID_DUMP_LINES && sysidNextSample(&logIndex, &sample); line++) {
+        //Header ahead of the first sample for the fitting tool, takes one of the lines
+        if (logIndex == 0) {
+            sysidRun_t run;
+            getSysidRun(&run);
+            p = fmtStr(statusStr, "SysID ");
+            p = fmtStr(p, run.axis == SYSID_MAIN ? "M " : "T ");
+            p = fmtStr(p, run.waveform == SYSID_PRBS ? "P " : "C ");
+            p = fmtFixed(p, run.amplitude, 2, 0);
+            p = fmtStr(p, " ");
+            p = fmtInt(p, run.samples, 0);
+            p = fmtStr(p, " ");
+            p = fmtInt(p, SYSID_RATE_HZ, 0);
+            fmtStr(p, run.overrun ? " OVERRUN\r\n" : " OK\r\n");
+            UARTSend (statusStr);
+            line++;
+        }
+
+        p = fmtStr(statusStr, "Log ");
+        p = fmtInt(p, logIndex, 0);
+        p = fmtStr(p, " ");
+        p = fmtInt(p, sample.input, 0);
+        p = fmtStr(p, " ");
+        p = fmtInt(p, sample.output, 0);
+        fmtStr(p, "\r\n");
+        UARTSend (statusStr);
+    }
+    return line > 0;
+}
+
+
+//*****************************************************************************
+// Send one of the telemetry lines that take turns
+//*****************************************************************************
+void
+sendTelemetryExtra (uint8_t slot)
+{
+    char *p = statusStr;
+
+    switch (slot) {
+        case TELEM_CPU:
+            p = fmtStr(p, "CPU % ");
+            p = fmtInt(p, getCpuLoad(), 0);
+            p = fmtStr(p, " | Takeoff ms ");
+            p = fmtInt(p, getTakeoffTime(), 0);
+            p = fmtStr(p, " | TX drop ");
+            p = fmtInt(p, getUARTDropped(), 0);
+            fmtStr(p, "  \r\n");
+            break;
+
+        case TELEM_FLIGHT:
+            //Takeoff overshoot and the learnt hover duty
+            p = fmtStr(p, "Overshoot % ");
+            p = fmtFixed(p, getTakeoffOvershoot(), 1, 0);
+            p = fmtStr(p, " | Hover % ");
+            p = fmtFixed(p, getHoverDuty(), 2, 0);
+            fmtStr(p, "  \r\n");
+            break;
+
+        case TELEM_PWM: {
+            //Actuation latency from setDuty() to the period both rotors latch on
+            pwmStats_t pwm;
+            getPwmStats(&pwm);
+            p = fmtStr(p, "PWM lat us ");
+            p = fmtInt(p, pwm.latencyUs, 0);
+            p = fmtStr(p, " | jitter us ");
+            p = fmtInt(p, (pwm.latencyMaxUs >= pwm.latencyMinUs) ?
+                          pwm.latencyMaxUs - pwm.latencyMinUs : 0, 0);
+            p = fmtStr(p, " | dropped ");
+            p = fmtInt(p, pwm.overwrites, 0);
+            fmtStr(p, "  \r\n");
+            break;
+        }
+
+        case TELEM_STACK:
+            updateStackMon();
+            p = fmtStr(p, "Stack ");
+            p = fmtInt(p, getStackHighWater(), 0);
+            p = fmtStr(p, "/");
+            p = fmtInt(p, getStackSize(), 0);
+            p = fmtStr(p, " | RAM free ");
+            p = fmtInt(p, getRamFree(), 0);
+            fmtStr(p, getStackAlert() ? " | STACK LOW \r\n" : " | OK \r\n");
+            break;
+
+#if ALT_MPC
+        case TELEM_MPC: {
+            //Explicit MPC region and evaluation cost against its budget
+            mpcStats_t mpc;
+            getMpcStats(&mpc);
+            p = fmtStr(p, "MPC region ");
+            p = fmtInt(p, mpc.region, 0);
+            p = fmtStr(p, " | cycles ");
+            p = fmtInt(p, mpc.cycles, 0);
+            p = fmtStr(p, "/");
+            p = fmtInt(p, mpc.cyclesMax, 0);
+            p = fmtStr(p, " | over ");
+            p = fmtInt(p, mpc.overBudget, 0);
+            p = fmtStr(p, " | infeas ");
+            p = fmtInt(p, mpc.infeasible, 0);
+            fmtStr(p, "  \r\n");
+            break;
+        }
+#endif
+    }
+    UARTSend (statusStr);
 }
 
 
@@ -125,17 +312,26 @@ int
 main(void)
 {
     uint16_t currentAlt;
-    int32_t currentYaw;
+    angle_t currentYaw;
+    sensorState_t sensors;
     uint16_t initLandedADC;
-    int32_t mainDuty;
-    int32_t tailDuty;
+    int32_t command[NUM_AXES];
+    int32_t thrustDemand;
+    int32_t thrustCut;
+    int32_t duty[NUM_ACTUATORS];
+    int32_t mainDuty = 0;       //Applied on the last mix, after the mixer's limits
+    int32_t tailDuty = 0;
     enum DisplayMode displayCycle = PROCESSED; //Display altitude percentage and yaw degrees
-    HelicopterState heliState = LANDED;
-    bool sweepEn = 0;   //Sweep yaw to find yaw ref point
+    uint8_t telemetrySlot = TELEM_CPU;
 
 
+    //Paint unused stack before anything else runs for high-water monitoring
+    paintStack();
+
     //Initialise all functions
     initClock ();
+    initPersist();
+    initHover();
     initButtons();
     initADC ();
     initDisplay ();
@@ -145,6 +341,7 @@ main(void)
     initialiseSwitch();
     initialiseResetButton();
     initialiseYawRef();
+    missionLoadDefault();
 
 
     // Enable interrupts to the processor.
@@ -158,6 +355,11 @@ main(void)
 
     //Set inital Max and Min altitudes 
     initAltLimits(initLandedADC);
+    initTailLoops();
+
+    //Report why the last run ended, then start supervising the tasks
+    reportBootReason();
+    initSupervisor();
 
     while (1)
     {
@@ -167,62 +369,148 @@ main(void)
         //Run main tasks
         //Run PID controller and set PWM levels
         if (flagController) {
-            //Update current sensor values
-            currentAlt = getAltMean();
-            currentYaw = getYawPosition();
-
-            mainDuty = controllerMain(currentAlt);
-            tailDuty = controllerTail(mainDuty, currentYaw, sweepEn);
+            //Take one coherent snapshot of the sensors for this tick
+            readSensorSnapshot(&sensors);
+            currentAlt = sensors.alt;
+            currentYaw = sensors.yaw;
+
+            //Sensor health checks, an altitude fault takes the main rotor open loop
+            healthCheck(currentAlt, currentYaw, getHelicopterState() != LANDED);
+
+            thrustDemand = controllerMain(currentAlt, getMixerOffset(ACT_MAIN));
+            command[AXIS_THRUST] = healthLimitThrust(thrustDemand);
+            thrustCut = command[AXIS_THRUST] - thrustDemand;
+            command[AXIS_YAW] = controllerTail(currentYaw);
+
+            //System identification excitation on top of the controllers
+            sysidExcite(command);
+
+            //Main rotor torque feed-forward from the main duty actually applied on the last mix,
+            //the rotor follows that and not a demand the mixer clipped or the excitation
+            command[AXIS_TORQUE] = couplingFeedForward(mainDuty, getHelicopterState() != LANDED);
+
+            //Mix thrust and yaw onto the rotors
+            mixerApply(command, duty);
+            mainDuty = duty[ACT_MAIN];
+            tailDuty = duty[ACT_TAIL];
+
+            //Unwind the integrals by whatever the health limit and mixer took off the loops
+            controllerMainTrack(thrustCut + getMixerCut(AXIS_THRUST));
+#if !YAW_RATE_LOOP
+            controllerTailTrack(getMixerCut(AXIS_YAW));
+#endif
+            sysidLog(duty, currentAlt, currentYaw);
+
+            //Learn the hover duty while holding altitude
+            hoverUpdate(currentAlt, mainDuty, getHelicopterState() == FLYING && !sysidRunning() &&
+                        !mixerSaturated(AXIS_THRUST) && !getHealthFaults());
 
             setDuty(mainDuty, tailDuty);
 
+            supervisorCheckIn(TASK_CONTROLLER);
             flagController = false;
         }
 
         //Pole buttons and state switch and update heli state
         if (flagButtons) {
 
-            heliState = updateHelicopterState(currentYaw, currentAlt);
-            if (heliState == TAKING_OFF) {
-                sweepEn = true;
-            } else {
-                sweepEn = false;
-            }
+            updateHelicopterState(currentYaw, currentAlt);
+            supervisorCheckIn(TASK_BUTTONS);
             flagButtons = false;
         }
 
         //Refresh BoosterPack OLED display
         if (flagDisplay) {
             displayWrite(initLandedADC, currentAlt, currentYaw, displayCycle);
+            supervisorCheckIn(TASK_DISPLAY);
             flagDisplay = false;
         }
 
         //Send new Heli stats to PC via UART
         if (flagUART) {
             
-            //Convert raw values to nice values for UART
-            int32_t actualAlt = getAltPercent(initLandedADC, currentAlt);
-            int32_t desireAlt = getAltPercent(initLandedADC, getAltSet());
-
-            int32_t actualYaw = getYawDegree(currentYaw) / SCALE_BY_100;
-            int32_t desireYaw = getYawDegree(getYawSet()) / SCALE_BY_100;
-
-            //Grab current Heli state as a string
-            char *heliString = getHeliState();
-
-            //Update UART string
-            usprintf (statusStr, "Alt(Actual/Set) %d/%d  \r\n", actualAlt, desireAlt);
-            UARTSend (statusStr);
-
-            usprintf (statusStr, "Yaw(Actual/Set) %d/%d  \r\n", actualYaw, desireYaw);
-            UARTSend (statusStr);
+            //Status telemetry stops during a system identification run to leave the loop to
+            //the controller, and a requested log takes over until it has been sent as the
+            //UART cannot carry both in an update
+            if (!sysidRunning() && !sendSysidLog()) {
+                //Convert raw values to nice values for UART
+                int32_t actualAlt = getAltPercent(initLandedADC, currentAlt);
+                int32_t desireAlt = getAltPercent(initLandedADC, getAltSet());
+
+                int32_t actualYaw = getYawDegree(currentYaw) / SCALE_BY_100;
+                int32_t desireYaw = getYawDegree(getYawSet()) / SCALE_BY_100;
+
+                //Grab current Heli state as a string
+                char *heliString = getHeliState();
+
+                char *p;
+
+                //Update UART string
+                p = fmtStr(statusStr, "Alt(Actual/Set) ");
+                p = fmtInt(p, actualAlt, 0);
+                p = fmtStr(p, "/");
+                p = fmtInt(p, desireAlt, 0);
+                p = fmtStr(p, " | Climb %/s ");
+                p = fmtFixed(p, getClimbRate(), 1, 0);
+                fmtStr(p, "  \r\n");
+                UARTSend (statusStr);
+
+                p = fmtStr(statusStr, "Yaw(Actual/Set) ");
+                p = fmtInt(p, actualYaw, 0);
+                p = fmtStr(p, "/");
+                p = fmtInt(p, desireYaw, 0);
+                fmtStr(p, "  \r\n");
+                UARTSend (statusStr);
+
+                p = fmtStr(statusStr, "Main % ");
+                p = fmtFixed(p, mainDuty, 2, 0);
+                p = fmtStr(p, " | Tail % ");
+                p = fmtFixed(p, tailDuty, 2, 0);
+                p = fmtStr(p, " | Mode ");
+                p = fmtStr(p, heliString);
+                p = fmtStr(p, " | Faults ");
+                p = fmtInt(p, getHealthFaults(), 0);
+                p = fmtStr(p, "/");
+                p = fmtInt(p, getFaultCount(), 0);
+                p = fmtStr(p, " | Spikes ");
+                p = fmtInt(p, getSpikeCount(), 0);
+                fmtStr(p, " \r\n");
+                UARTSend (statusStr);
+
+                //A completed mission segment takes the turn of the next rotating line
+                uint8_t segment;
+                segmentResult_t result;
+                if (missionNextResult(&segment, &result)) {
+                    p = fmtStr(statusStr, "Seg ");
+                    p = fmtInt(p, segment, 0);
+                    p = fmtStr(p, " err Alt% ");
+                    p = fmtFixed(p, result.altErr, 1, 0);
+                    p = fmtStr(p, " Yaw ");
+                    p = fmtFixed(p, result.yawErr, 1, 0);
+                    fmtStr(p, " \r\n");
+                    UARTSend (statusStr);
+                } else {
+                    sendTelemetryExtra(telemetrySlot);
+                    telemetrySlot = (telemetrySlot + 1) % NUM_TELEM_EXTRA;
+                }
+            }
 
-            usprintf (statusStr, "Main %% %d | Tail %% %d | Mode %s \r\n", mainDuty, tailDuty, heliString);
-            UARTSend (statusStr);
+            //Handle a mission or system identification command line from the PC
+            if (UARTGetLine(commandStr)) {
+                bool ok = missionCommand(commandStr) || sysidCommand(commandStr);
+                UARTSend (ok ? "OK\r\n" : "ERR\r\n");
+            }
 
 
+            supervisorCheckIn(TASK_UART);
             flagUART = false;
         }
 
+        //Sleep until the next interrupt when no task is pending
+        IntMasterDisable();
+        if (!(flagController || flagButtons || flagDisplay || flagUART)) {
+            cpuIdleSleep();
+        }
+        IntMasterEnable();
     }
 }
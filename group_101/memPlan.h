@@ -0,0 +1,70 @@
+/*
+ * memPlan.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+
+//*****************************************************************************
+// Static memory plan. Every run-time buffer is sized here at compile time and
+// allocated statically by the module that owns it, there is no heap. Each
+// module's figure covers all of its file scope and function static state,
+// rounded up to a word. tools/memCheck.py reads the MODULE SUMMARY in the
+// linker map (Debug/<project>.map) and flags any module whose rw data has
+// outgrown its figure, run it after a build that adds state.
+//*****************************************************************************
+
+//Buffer sizes
+#define BUF_SIZE 60             //ADC altitude samples, 30 ms at the dual ADC ALT_SAMPLE_RATE_HZ
+#define MAX_STR_LEN 105         //UART telemetry line
+#define UART_RX_LEN 32          //UART command line
+#define UART_TX_LEN 512         //UART transmit ring, power of two, ~0.5 s at 9600 baud
+#define MISSION_MAX_SEGMENTS 16 //Mission waypoint table
+#define DISPLAY_LINE_LEN 16     //16 characters across the OLED
+#define SYSID_LOG_LEN 2000      //System identification log, 8 s at the 250 Hz controller rate
+
+//SRAM used per module in bytes, buffers then fixed state
+#define MEM_ADC_BYTES      ((BUF_SIZE + 1) / 2 * sizeof(uint32_t) + 96)   //Packed samples, buffer
+                                //struct 16, two biquads 48, median history 12, sums and counts 20
+#define MEM_UART_BYTES     (2 * (UART_RX_LEN + 1) + UART_TX_LEN + 12)     //Rx lines, tx ring, indices
+#define MEM_MAIN_BYTES     (MAX_STR_LEN + 1 + UART_RX_LEN + 1 + 8)        //Telemetry and command
+                                                                            //lines, task flags
+#define MEM_MISSION_BYTES  (MISSION_MAX_SEGMENTS * 16 + 32)   //Segments and results 8 each
+#define MEM_DISPLAY_BYTES  (DISPLAY_LINE_LEN + 1 + 3)
+#define MEM_SYSID_BYTES    (SYSID_LOG_LEN * 4 + 32)
+#define MEM_CONTROL_BYTES  184  //pwmRotor: four pidCtrl_t 144, set points, estimator, yaw latch
+#define MEM_MIXER_BYTES    48   //Gains 12, offsets 8, per axis cut 12 and latched commands 12
+#define MEM_PWM_BYTES      60   //pwmStats_t 32, periods and the pending duty pair
+#define MEM_HEALTH_BYTES   36
+#define MEM_HELISTATE_BYTES 48  //State, yaw sweep and reference, takeoff timing
+#define MEM_HOVER_BYTES    12
+#define MEM_QUAD_BYTES     28   //Edge count and timing, yaw rate
+#define MEM_SENSOR_BYTES   20   //Published sensorState_t and the tick count
+#define MEM_SUPERVISOR_BYTES 36 //Check in ticks and name pointers per task, flags
+#define MEM_MPC_BYTES      20   //mpcStats_t, the region table is in flash
+#define MEM_MISC_BYTES     32   //buttons4 16, cpuLoad 8, stackMon 8, coupling 4, persist 1
+#define MEM_OLED_BYTES     836  //OrbitOLED frame buffer and character state, the font is in flash
+#define MEM_VTABLE_BYTES   620  //Interrupt vector table copied to SRAM by IntRegister()
+#define MEM_STDLIB_BYTES   4    //ustdlib
+#define MEM_HEAP_BYTES     0    //Must match --heap_size, nothing allocates
+#define MEM_STACK_BYTES    512  //Must match --stack_size in the project settings
+
+#define SRAM_BYTES 0x8000
+#define MEM_PLAN_BYTES (MEM_ADC_BYTES + MEM_UART_BYTES + MEM_MAIN_BYTES + MEM_DISPLAY_BYTES + \
+                        MEM_MISSION_BYTES + MEM_SYSID_BYTES + MEM_CONTROL_BYTES + \
+                        MEM_MIXER_BYTES + MEM_PWM_BYTES + MEM_HEALTH_BYTES + \
+                        MEM_HELISTATE_BYTES + MEM_HOVER_BYTES + MEM_QUAD_BYTES + \
+                        MEM_SENSOR_BYTES + MEM_SUPERVISOR_BYTES + MEM_MPC_BYTES + \
+                        MEM_MISC_BYTES + MEM_OLED_BYTES + MEM_VTABLE_BYTES + \
+                        MEM_STDLIB_BYTES + MEM_HEAP_BYTES + MEM_STACK_BYTES)
+
+
+#ifndef MEMPLAN_H_
+#define MEMPLAN_H_
+
+//Fails to compile (negative array size) if the plan outgrows SRAM
+typedef char memPlanFits[(MEM_PLAN_BYTES <= SRAM_BYTES) ? 1 : -1];
+
+#endif /* MEMPLAN_H_ */
@@ -0,0 +1,287 @@
+/*
+ * mission.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "mission.h"
+
+#define MISSION_ALT_MIN 10      //Lowest mission altitude %, matches the DOWN button limit
+#define MISSION_ALT_MAX 100
+
+//Compiled in benchmark manoeuvre
+static const missionSegment_t defaultMission[] = {
+    { SEG_STEP, 20,   0, 4000 },
+    { SEG_RAMP, 50,  90, 4000 },
+    { SEG_HOLD,  0,   0, 3000 },
+    { SEG_STEP, 30, -90, 4000 },
+    { SEG_RAMP, 60, 180, 6000 },
+    { SEG_STEP, 20,   0, 5000 },
+};
+
+static missionSegment_t segments[MISSION_MAX_SEGMENTS];
+static segmentResult_t results[MISSION_MAX_SEGMENTS];
+static uint8_t numSegments = 0;
+static uint8_t numResults = 0;
+static uint8_t reportIndex = 0;     //Next result to hand to telemetry
+
+static bool armed = false;
+static bool running = false;
+static uint8_t current = 0;         //Segment being flown
+static uint32_t segStart = 0;       //Tick the segment started
+static int16_t startAltSet = 0;     //Setpoints when the segment started, for ramps
+static angle_t startYawSet = 0;
+
+//Tracking error accumulators for the current segment
+static uint32_t altErrSum = 0;
+static uint32_t yawErrSum = 0;
+static uint32_t samples = 0;
+
+
+//Convert a mission altitude percentage to an altitude ADC setpoint, missionAppend() has
+//already kept it in range
+static int16_t
+altPercentToADC (int8_t altPercent)
+{
+    return getmin_alt() - (int32_t) altPercent * ADC_STEP_FOR_1V / 100;
+}
+
+
+//Start flying segment i from the current setpoints
+static void
+beginSegment (uint8_t i)
+{
+    const missionSegment_t *seg = &segments[i];
+
+    current = i;
+    segStart = getSensorTick();
+    startAltSet = getAltSet();
+    startYawSet = getYawSet();
+    altErrSum = 0;
+    yawErrSum = 0;
+    samples = 0;
+
+    if (seg->type == SEG_STEP) {
+        setAlt(altPercentToADC(seg->altPercent));
+        setYaw(ANGLE_FROM_DEG(seg->yawDeg));
+    }
+}
+
+
+//Record the mean tracking error of the current segment and move to the next one
+static void
+endSegment (void)
+{
+    segmentResult_t *result = &results[current];
+
+    result->samples = samples;
+    if (samples > 0) {
+        result->altErr = (uint64_t) altErrSum * 1000 / ADC_STEP_FOR_1V / samples;
+        result->yawErr = yawErrSum / 10 / samples;
+    } else {
+        result->altErr = 0;
+        result->yawErr = 0;
+    }
+    numResults = current + 1;
+
+    if (current + 1 < numSegments) {
+        beginSegment(current + 1);
+    } else {
+        running = false;
+    }
+}
+
+
+//Replace the table with the compiled in mission
+void
+missionLoadDefault (void)
+{
+    uint8_t i;
+
+    missionClear();
+    for (i = 0; i < sizeof(defaultMission) / sizeof(defaultMission[0]); i++) {
+        missionAppend(&defaultMission[i]);
+    }
+    armed = MISSION_AUTORUN;
+}
+
+
+//Add a segment to the end of the table, fails if full, while running or if a step or ramp
+//altitude is outside MISSION_ALT_MIN to MISSION_ALT_MAX. A hold's altitude is not used.
+bool
+missionAppend (const missionSegment_t *segment)
+{
+    if (running || numSegments >= MISSION_MAX_SEGMENTS || segment->type > SEG_HOLD) {
+        return false;
+    }
+    if (segment->type != SEG_HOLD &&
+        (segment->altPercent < MISSION_ALT_MIN || segment->altPercent > MISSION_ALT_MAX)) {
+        return false;
+    }
+    segments[numSegments++] = *segment;
+    return true;
+}
+
+
+//Empty the table
+void
+missionClear (void)
+{
+    missionAbort();
+    numSegments = 0;
+}
+
+
+//Run the table next time FLYING
+void
+missionArm (void)
+{
+    armed = numSegments > 0;
+}
+
+
+//Called on each FLYING pass of the state machine, starts an armed mission
+void
+missionStartIfArmed (void)
+{
+    if (armed && !running) {
+        armed = false;
+        running = true;
+        numResults = 0;
+        reportIndex = 0;
+        beginSegment(0);
+    }
+}
+
+
+//Stop the mission and leave the setpoints where they are
+void
+missionAbort (void)
+{
+    armed = false;
+    running = false;
+}
+
+
+bool
+missionRunning (void)
+{
+    return running;
+}
+
+
+// *******************************************************
+// missionUpdate: Called on each FLYING pass of the state machine, at the 100 Hz button
+// rate, moves the setpoints along the current segment and accumulates tracking error
+// against them. Segment time is the SysTick count, so a ramp steps its setpoints every pass
+// and a segment ends on the first pass after its duration whatever the call rate.
+void
+missionUpdate (angle_t yaw, uint16_t alt)
+{
+    if (!running) {
+        return;
+    }
+
+    const missionSegment_t *seg = &segments[current];
+    uint32_t elapsed = getSensorTick() - segStart;
+
+    if (seg->type == SEG_RAMP) {
+        int16_t targetAlt = altPercentToADC(seg->altPercent);
+        angle_t targetYaw = ANGLE_FROM_DEG(seg->yawDeg);
+
+        if (elapsed < seg->durationMs) {
+            int32_t dAlt = targetAlt - startAltSet;
+            int32_t dYaw = (int32_t) (targetYaw - startYawSet);   //Shortest turn
+
+            setAlt(startAltSet + dAlt * (int32_t) elapsed / (int32_t) seg->durationMs);
+            setYaw(startYawSet + (int32_t) ((int64_t) dYaw * elapsed / seg->durationMs));
+        } else {
+            setAlt(targetAlt);
+            setYaw(targetYaw);
+        }
+    }
+
+    int32_t altErr = (int32_t) alt - getAltSet();
+    int32_t yawErr = angleToCentiDeg(getYawSet() - yaw);
+    altErrSum += altErr < 0 ? -altErr : altErr;
+    yawErrSum += yawErr < 0 ? -yawErr : yawErr;
+    samples++;
+
+    if (elapsed >= seg->durationMs) {
+        endSegment();
+    }
+}
+
+
+// *******************************************************
+// missionCommand: Handle a UART command line, returns false if it was not understood.
+//   MC                        clear the table
+//   MD                        load the compiled in mission
+//   MA <S|R|H> alt% yaw ms    append a step, ramp or hold segment, alt% from
+//                             MISSION_ALT_MIN to 100 except for a hold
+//   MG                        arm, runs from FLYING
+//   MX                        abort
+bool
+missionCommand (const char *line)
+{
+    if (line[0] != 'M') {
+        return false;
+    }
+
+    switch (line[1]) {
+        case 'C':
+            missionClear();
+            return true;
+        case 'D':
+            missionLoadDefault();
+            return true;
+        case 'G':
+            missionArm();
+            return true;
+        case 'X':
+            missionAbort();
+            return true;
+        case 'A':
+        {
+            missionSegment_t seg;
+            int32_t alt, yaw, ms;
+            const char *p = line + 2;
+
+            while (*p == ' ') {
+                p++;
+            }
+            switch (*p++) {
+                case 'S': seg.type = SEG_STEP; break;
+                case 'R': seg.type = SEG_RAMP; break;
+                case 'H': seg.type = SEG_HOLD; break;
+                default: return false;
+            }
+            if (!(p = parseInt(p, &alt)) || !(p = parseInt(p, &yaw)) || !(p = parseInt(p, &ms))) {
+                return false;
+            }
+            if (alt < 0 || alt > MISSION_ALT_MAX || ms <= 0) {
+                return false;
+            }
+            seg.altPercent = alt;
+            seg.yawDeg = yaw;
+            seg.durationMs = ms;
+            return missionAppend(&seg);
+        }
+        default:
+            return false;
+    }
+}
+
+
+//Hand the next unreported segment result to telemetry, false when there is none
+bool
+missionNextResult (uint8_t *segment, segmentResult_t *result)
+{
+    if (reportIndex >= numResults) {
+        return false;
+    }
+    *segment = reportIndex;
+    *result = results[reportIndex++];
+    return true;
+}
@@ -0,0 +1,62 @@
+/*
+ * mission.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "memPlan.h"
+#include "yawAngle.h"
+#include "pwmRotor.h"
+#include "sensorState.h"
+#include "fastFmt.h"
+
+#define MISSION_AUTORUN 0   //Set to 1 to run the loaded mission as soon as FLYING is reached
+
+
+#ifndef MISSION_H_
+#define MISSION_H_
+
+//Segment types
+enum segmentType { SEG_STEP = 0, SEG_RAMP, SEG_HOLD };
+
+// *******************************************************
+// One waypoint. STEP jumps the setpoints to the target, RAMP moves them linearly to
+// the target over the duration and HOLD keeps the previous setpoints.
+typedef struct {
+    uint8_t type;           //segmentType
+    int8_t altPercent;      //Target altitude, % of 1 V above landed
+    int16_t yawDeg;         //Target yaw, degrees from the reference
+    uint32_t durationMs;
+} missionSegment_t;
+
+// Mean absolute tracking error over a completed segment
+typedef struct {
+    uint16_t altErr;        //Altitude error, tenths of a %
+    uint16_t yawErr;        //Yaw error, tenths of a degree
+    uint32_t samples;
+} segmentResult_t;
+
+void missionLoadDefault (void);
+
+bool missionAppend (const missionSegment_t *segment);
+
+void missionClear (void);
+
+void missionArm (void);
+
+void missionStartIfArmed (void);
+
+void missionAbort (void);
+
+bool missionRunning (void);
+
+void missionUpdate (angle_t yaw, uint16_t alt);
+
+bool missionCommand (const char *line);
+
+bool missionNextResult (uint8_t *segment, segmentResult_t *result);
+
+#endif /* MISSION_H_ */
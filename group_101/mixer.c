@@ -0,0 +1,208 @@
+/*
+ * mixer.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "mixer.h"
+
+//Actuator duty = offset + sum of gain * command, one row per actuator
+//The tail cancels main rotor torque either through the torque feed-forward or statically
+//through a thrust gain, then yaws
+#if COUPLING_DYNAMIC
+static int16_t mixGain[NUM_ACTUATORS][NUM_AXES] = {
+    { MIXER_UNITY, 0, 0 },
+    { 0, MIXER_UNITY, MIXER_UNITY }
+};
+
+static int32_t mixOffset[NUM_ACTUATORS] = {
+    DUTY_PERCENT(GRAVITY),
+    0
+};
+#else
+static int16_t mixGain[NUM_ACTUATORS][NUM_AXES] = {
+    { MIXER_UNITY, 0, 0 },
+    { (int16_t) (KC * MIXER_UNITY), MIXER_UNITY, 0 }
+};
+
+static int32_t mixOffset[NUM_ACTUATORS] = {
+    DUTY_PERCENT(GRAVITY),
+    DUTY_PERCENT(KC * GRAVITY)
+};
+#endif
+
+//Per actuator duty limits
+static const int32_t mixMin[NUM_ACTUATORS] = {
+    DUTY_PERCENT(PWM_DUTY_MAIN_MIN),
+    DUTY_PERCENT(PWM_DUTY_TAIL_MIN)
+};
+static const int32_t mixMax[NUM_ACTUATORS] = {
+    DUTY_PERCENT(PWM_DUTY_MAIN_MAX),
+    DUTY_PERCENT(PWM_DUTY_TAIL_MAX)
+};
+
+//Axes are mixed highest priority first, later axes only get the headroom left over.
+//Torque cancellation always goes ahead of yaw so yaw effort is what gets cut.
+#if MIXER_YAW_PRIORITY
+static const uint8_t axisOrder[NUM_AXES] = { AXIS_TORQUE, AXIS_YAW, AXIS_THRUST };
+#else
+static const uint8_t axisOrder[NUM_AXES] = { AXIS_THRUST, AXIS_TORQUE, AXIS_YAW };
+#endif
+
+//Applied minus requested command per axis on the last mix, non-zero where an axis was cut
+static int32_t mixCut[NUM_AXES];
+
+//Commands from the last mixerApply(), remixed by the yaw rate loop between controller ticks
+static volatile int32_t latched[NUM_AXES];
+static volatile bool latchValid = false;
+
+
+// *******************************************************
+// mix: Map the virtual commands onto actuator duties. Each axis in priority order is
+// limited to the range that keeps every actuator it drives within its limits, given the
+// axes already mixed, so saturation takes authority from the lower priority axis first.
+// Fills cut with how far each axis was cut back.
+static void
+mix (const int32_t command[NUM_AXES], int32_t duty[NUM_ACTUATORS], int32_t cut[NUM_AXES])
+{
+    //Actuator sums, scaled by MIXER_UNITY
+    int32_t sum[NUM_ACTUATORS];
+    uint8_t i;
+    uint8_t j;
+
+    for (i = 0; i < NUM_ACTUATORS; i++) {
+        sum[i] = mixOffset[i] * MIXER_UNITY;
+    }
+
+    for (j = 0; j < NUM_AXES; j++) {
+        uint8_t axis = axisOrder[j];
+        int32_t lo = INT32_MIN;
+        int32_t hi = INT32_MAX;
+        int32_t limited = command[axis];
+
+        //Intersect the command ranges each actuator allows
+        for (i = 0; i < NUM_ACTUATORS; i++) {
+            int32_t gain = mixGain[i][axis];
+            int32_t below = mixMin[i] * MIXER_UNITY - sum[i];
+            int32_t above = mixMax[i] * MIXER_UNITY - sum[i];
+
+            if (gain > 0) {
+                if (below / gain > lo) lo = below / gain;
+                if (above / gain < hi) hi = above / gain;
+            } else if (gain < 0) {
+                if (above / gain > lo) lo = above / gain;
+                if (below / gain < hi) hi = below / gain;
+            }
+        }
+
+        if (limited > hi) {
+            limited = hi;
+        }
+        if (limited < lo) {
+            limited = lo;
+        }
+        cut[axis] = limited - command[axis];
+
+        for (i = 0; i < NUM_ACTUATORS; i++) {
+            sum[i] += mixGain[i][axis] * limited;
+        }
+    }
+
+    //Final clamp also covers higher priority axes that alone exceed a limit
+    for (i = 0; i < NUM_ACTUATORS; i++) {
+        duty[i] = sum[i] / MIXER_UNITY;
+        if (duty[i] > mixMax[i]) {
+            duty[i] = mixMax[i];
+        } else if (duty[i] < mixMin[i]) {
+            duty[i] = mixMin[i];
+        }
+    }
+}
+
+
+//Mix the controller commands and keep them for mixerRemix()
+void
+mixerApply (const int32_t command[NUM_AXES], int32_t duty[NUM_ACTUATORS])
+{
+    uint8_t j;
+
+    for (j = 0; j < NUM_AXES; j++) {
+        latched[j] = command[j];
+    }
+    latchValid = true;
+
+    mix(command, duty, mixCut);
+}
+
+
+// *******************************************************
+// mixerRemix: Called from the SysTick ISR. Mix the last controller commands again with
+// change added to one axis, so a faster inner loop can move its actuator between
+// controller ticks. A remix part way through mixerApply() copying the commands sees one
+// axis a tick old, which only lasts until the next remix. Returns false until the first
+// mixerApply(), otherwise cut is set to how far the axis was cut back. Saturation flags
+// are left to the controller tick.
+bool
+mixerRemix (uint8_t axis, int32_t change, int32_t duty[NUM_ACTUATORS], int32_t *cut)
+{
+    int32_t command[NUM_AXES];
+    int32_t remixCut[NUM_AXES];
+    uint8_t j;
+
+    if (!latchValid || axis >= NUM_AXES) {
+        return false;
+    }
+    for (j = 0; j < NUM_AXES; j++) {
+        command[j] = latched[j];
+    }
+    command[axis] += change;
+
+    mix(command, duty, remixCut);
+    *cut = remixCut[axis];
+    return true;
+}
+
+
+//Set one mixer gain, MIXER_UNITY is a gain of 1
+void
+mixerSetGain (uint8_t actuator, uint8_t axis, int16_t gain)
+{
+    if (actuator < NUM_ACTUATORS && axis < NUM_AXES) {
+        mixGain[actuator][axis] = gain;
+    }
+}
+
+
+//Set an actuator offset in DUTY_SCALE units
+void
+mixerSetOffset (uint8_t actuator, int32_t offset)
+{
+    if (actuator < NUM_ACTUATORS) {
+        mixOffset[actuator] = offset;
+    }
+}
+
+
+//Get an actuator offset in DUTY_SCALE units
+int32_t
+getMixerOffset (uint8_t actuator)
+{
+    return (actuator < NUM_ACTUATORS) ? mixOffset[actuator] : 0;
+}
+
+
+//True if the axis was cut back to keep the actuators in limits on the last mix
+bool
+mixerSaturated (uint8_t axis)
+{
+    return getMixerCut(axis) != 0;
+}
+
+
+//Applied minus requested command on the last mix, DUTY_SCALE units
+int32_t
+getMixerCut (uint8_t axis)
+{
+    return (axis < NUM_AXES) ? mixCut[axis] : 0;
+}
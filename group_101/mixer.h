@@ -0,0 +1,47 @@
+/*
+ * mixer.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pwmRotor.h"
+#include "coupling.h"
+
+//Mixer gains are fixed point, MIXER_UNITY is a gain of 1
+#define MIXER_UNITY 1000
+
+//Default hover duty offset on the main rotor
+#define GRAVITY 31
+
+//Set to 0 to keep thrust and give up yaw authority when the rotors saturate
+#define MIXER_YAW_PRIORITY 1
+
+
+#ifndef MIXER_H_
+#define MIXER_H_
+
+//Virtual commands from the controllers, DUTY_SCALE units. AXIS_TORQUE is the main rotor
+//torque feed-forward from couplingFeedForward().
+enum mixerAxis { AXIS_THRUST = 0, AXIS_YAW, AXIS_TORQUE, NUM_AXES };
+
+//Physical actuators
+enum mixerActuator { ACT_MAIN = 0, ACT_TAIL, NUM_ACTUATORS };
+
+void mixerApply (const int32_t command[NUM_AXES], int32_t duty[NUM_ACTUATORS]);
+
+bool mixerRemix (uint8_t axis, int32_t change, int32_t duty[NUM_ACTUATORS], int32_t *cut);
+
+void mixerSetGain (uint8_t actuator, uint8_t axis, int16_t gain);
+
+void mixerSetOffset (uint8_t actuator, int32_t offset);
+
+int32_t getMixerOffset (uint8_t actuator);
+
+bool mixerSaturated (uint8_t axis);
+
+int32_t getMixerCut (uint8_t axis);
+
+#endif /* MIXER_H_ */
@@ -0,0 +1,86 @@
+/*
+ * mpc.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "mpc.h"
+
+// *******************************************************
+// Explicit MPC for the altitude axis. tools/mpcSolve.py solves the constrained problem
+// offline from the rate model that tools/sysidFit.py fits, e in ADC counts above the
+// setpoint, v in counts/s and u in percent main duty about hover:
+//   e' = v,  v' = -a v + b u
+// with the duty limits and the ALT_RATE_MAX climb rate limit over the horizon, at
+// MPC_PERIOD_TICKS controller ticks per step. The climb limit is a state constraint so
+// the partition is not the clamped LQR law: near the limit the first move brakes early.
+// Re-run the solver if the model, weights, limits or step change; the table lives in
+// mpcTable.c.
+
+static mpcStats_t mpcStats = { MPC_NO_REGION, 0, 0, 0, 0 };
+
+
+// *******************************************************
+// mpcEvaluate: Sequential search for the region containing the state, then its affine law.
+// At most MPC_REGIONS * MPC_MAX_PLANES half-plane tests so the worst case is fixed. A state
+// no input sequence can bring inside the climb limit is in no region; it takes the law of
+// the region it violates least, the nearest feasible behaviour, clamped to the limits.
+// Returns percent duty about hover.
+float
+mpcEvaluate (float heightErr, float climbRate)
+{
+    uint32_t start = HWREG(DWT_CYCCNT_REG);
+    const mpcRegion_t *r = &mpcTable[0];
+    uint8_t region = MPC_NO_REGION;
+    float leastWorst = 0;
+    uint8_t i;
+    uint8_t j;
+    float u;
+
+    for (i = 0; i < MPC_REGIONS && region == MPC_NO_REGION; i++) {
+        float worst = 0;
+        for (j = 0; j < mpcTable[i].planes; j++) {
+            const float *h = mpcTable[i].h[j];
+            float excess = h[0] * heightErr + h[1] * climbRate - h[2];
+            if (excess > worst) {
+                worst = excess;
+            }
+        }
+        if (worst <= 0) {
+            region = i;
+            r = &mpcTable[i];
+        } else if (i == 0 || worst < leastWorst) {
+            leastWorst = worst;
+            r = &mpcTable[i];
+        }
+    }
+
+    u = r->f[0] * heightErr + r->f[1] * climbRate + r->f[2];
+    if (u > MPC_U_MAX) {
+        u = MPC_U_MAX;
+    } else if (u < MPC_U_MIN) {
+        u = MPC_U_MIN;
+    }
+
+    mpcStats.region = region;
+    if (region == MPC_NO_REGION) {
+        mpcStats.infeasible++;
+    }
+    mpcStats.cycles = HWREG(DWT_CYCCNT_REG) - start;
+    if (mpcStats.cycles > mpcStats.cyclesMax) {
+        mpcStats.cyclesMax = mpcStats.cycles;
+    }
+    if (mpcStats.cycles > MPC_CYCLE_BUDGET) {
+        mpcStats.overBudget++;
+    }
+    return u;
+}
+
+
+//Copy the evaluation timing
+void
+getMpcStats (mpcStats_t *stats)
+{
+    *stats = mpcStats;
+}
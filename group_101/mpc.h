@@ -0,0 +1,46 @@
+/*
+ * mpc.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pwmDriver.h"
+#include "mpcTable.h"
+
+#define MPC_CYCLE_BUDGET 2000   //Evaluation budget, 100 us at the 20 MHz system clock
+
+
+#ifndef MPC_H_
+#define MPC_H_
+
+// *******************************************************
+// Explicit MPC region: the law u = f[0]*e + f[1]*v + f[2] holds where every
+// h[i][0]*e + h[i][1]*v <= h[i][2], e the height error and v the climb rate.
+typedef struct {
+    float h[MPC_MAX_PLANES][3];
+    float f[3];
+    uint8_t planes;
+} mpcRegion_t;
+
+//Region table from tools/mpcSolve.py
+extern const mpcRegion_t mpcTable[MPC_REGIONS];
+
+//Evaluation timing, cycles
+typedef struct {
+    uint8_t region;         //Region of the last evaluation, MPC_NO_REGION if outside the table
+    uint32_t cycles;        //Last evaluation
+    uint32_t cyclesMax;     //Worst since start up
+    uint32_t overBudget;    //Evaluations that took longer than MPC_CYCLE_BUDGET
+    uint32_t infeasible;    //States outside every region
+} mpcStats_t;
+
+#define MPC_NO_REGION 0xFF
+
+float mpcEvaluate (float heightErr, float climbRate);
+
+void getMpcStats (mpcStats_t *stats);
+
+#endif /* MPC_H_ */
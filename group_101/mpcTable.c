@@ -0,0 +1,52 @@
+/*
+ * mpcTable.c
+ *
+ *  Generated by tools/mpcSolve.py, do not edit.
+ *  a = 2, b = 40, 20 ms steps, horizon 4, Q = diag(1, 0.02), R = 80, u in [-16, 49], |v| <= 310
+ */
+
+#include "mpc.h"
+
+//Largest region first, unused half-planes are zero
+const mpcRegion_t mpcTable[MPC_REGIONS] = {
+    { { { 0.0, 1.0, 335.7108 }, { -0.9327075, -0.3606337, -149.2975 }, { 0.0, -1.0, 308.2649 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, -16.0 }, 3 },
+    { { { 0.0, 1.0, 193.7477 }, { 0.0, -1.0, 362.6459 }, { 0.9327075, 0.3606337, -457.2236 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, 49.0 }, 3 },
+    { { { 0.9371888, 0.3488226, 136.3548 }, { -0.0924643, 0.995716, 332.3732 }, { -0.1896356, 0.9818545, 353.5939 }, { -0.2889833, 0.9573341, 372.7307 }, { -0.3874322, 0.9218982, 388.9322 }, { -0.9371888, -0.3488226, 417.5865 }, { 0.0924643, -0.995716, 332.3732 } },
+      { -0.1099706, -0.04093118, 0.0 }, 7 },
+    { { { 0.0, -1.0, 362.6459 }, { 0.0, 1.0, -309.5919 }, { -0.0924643, 0.995716, -332.3732 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, -1.225167, -395.3017 }, 3 },
+    { { { -0.04088196, 0.999164, 317.3566 }, { -0.04848951, -0.9988237, -177.3853 }, { 0.3874322, -0.9218982, -388.9322 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { -0.01316928, -0.2712708, 97.17614 }, 3 },
+    { { { 0.0, 1.0, 335.7108 }, { 0.007016729, -0.9999754, -311.2622 }, { 0.9999507, 0.009932845, -271.8363 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, -1.225167, 395.3017 }, 3 },
+    { { { 0.0, -1.0, -193.7477 }, { 0.1047459, -0.994499, -251.8763 }, { 0.2063819, -0.9784715, -304.6225 }, { 0.3014257, -0.9534897, -350.5248 }, { 0.04848951, 0.9988237, 177.3853 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, 49.0 }, 5 },
+    { { { -0.02074391, 0.9997848, 313.7424 }, { 0.04088196, -0.999164, -317.3566 }, { 0.9995533, 0.02988488, -265.5674 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { -0.008861087, -0.376564, 130.6196 }, 3 },
+    { { { -0.007016729, 0.9999754, 311.2622 }, { 0.02074391, -0.9997848, -313.7424 }, { 0.9998016, 0.01992059, -268.7057 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { -0.004469302, -0.5882328, 197.0433 }, 3 },
+    { { { -0.1047459, 0.994499, 251.8763 }, { -0.9327075, -0.3606337, 457.2236 }, { 0.0, -1.0, 362.6459 }, { 0.9341535, 0.3568716, -443.8578 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, 49.0 }, 4 },
+    { { { -0.2063819, 0.9784715, 304.6225 }, { -0.9341535, -0.3568716, 443.8578 }, { 0.0, -1.0, 362.6459 }, { 0.9356469, 0.3529374, -430.6434 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, 49.0 }, 4 },
+    { { { -0.3014257, 0.9534897, 350.5248 }, { -0.9356469, -0.3529374, 430.6434 }, { 0.0, -1.0, 362.6459 }, { 0.9371888, 0.3488226, -417.5865 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, 49.0 }, 4 },
+    { { { -0.9999507, -0.009932845, 271.8363 }, { 0.006776681, -0.999977, -311.1967 }, { 0.0924643, -0.995716, -332.3732 }, { 0.0, 1.0, 335.7108 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, -1.225167, 395.3017 }, 4 },
+    { { { 0.9327075, 0.3606337, 149.2975 }, { 0.0, 1.0, 335.7108 }, { -0.9341535, -0.3568716, -144.9332 }, { 0.0, -1.0, 308.725 }, { 0.1047459, -0.994499, 335.8205 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, -16.0 }, 5 },
+    { { { 0.9341535, 0.3568716, 144.9332 }, { 0.0, 1.0, 335.7108 }, { -0.9356469, -0.3529374, -140.6183 }, { 0.0, -1.0, 309.1671 }, { 0.1004758, -0.9949395, 334.6017 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, -16.0 }, 5 },
+    { { { 0.9356469, 0.3529374, 140.6183 }, { 0.0, 1.0, 335.7108 }, { -0.9371888, -0.3488226, -136.3548 }, { 0.0, -1.0, 309.5919 }, { 0.09638454, -0.9953442, 333.4538 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, -16.0 }, 5 },
+    { { { -0.9988685, -0.04755758, -259.8983 }, { 0.0, -1.0, 309.1671 }, { 0.0, 1.0, -308.2649 }, { -0.1047459, 0.994499, -335.8205 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, -16.0 }, 4 },
+    { { { 0.0, 1.0, -309.1671 }, { -0.9995754, -0.02913675, -265.7878 }, { 0.0, -1.0, 309.5919 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { 0.0, 0.0, -16.0 }, 3 },
+    { { { -0.006856697, 0.9999765, 311.2185 }, { -0.9998016, -0.01992059, 268.7057 }, { 0.02026354, -0.9997947, -313.6134 }, { 0.9998016, 0.01992059, -262.5065 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { -0.004367379, -0.5882307, 197.0707 }, 4 },
+    { { { -0.02026354, 0.9997947, 313.6134 }, { -0.9995533, -0.02988488, 265.5674 }, { 0.2889833, -0.9573341, -372.7307 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } },
+      { -0.008657503, -0.3765579, 130.6737 }, 3 }
+};
@@ -0,0 +1,12 @@
+/*
+ * mpcTable.h
+ *
+ *  Generated by tools/mpcSolve.py, do not edit.
+ *  a = 2, b = 40, 20 ms steps, horizon 4, Q = diag(1, 0.02), R = 80, u in [-16, 49], |v| <= 310
+ */
+
+#define MPC_REGIONS 20
+#define MPC_MAX_PLANES 7
+#define MPC_PERIOD_TICKS 5    //Controller ticks per MPC step, the period the table was solved for
+#define MPC_U_MIN -16.0
+#define MPC_U_MAX 49.0
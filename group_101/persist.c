@@ -0,0 +1,56 @@
+/*
+ * persist.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "persist.h"
+
+#define PERSIST_SLOT_BYTES 8    //Value then its complement
+
+static bool persistOk = false;  //EEPROM initialised without error
+
+
+//Enable the EEPROM, slots read as invalid if it fails to initialise
+void
+initPersist (void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0)) {
+    }
+    persistOk = (EEPROMInit() == EEPROM_INIT_OK);
+}
+
+
+//Read a slot, returns false if it has never been written or is corrupt
+bool
+persistRead (uint8_t slot, uint32_t *value)
+{
+    uint32_t words[2];
+
+    if (!persistOk || slot >= NUM_PERSIST_SLOTS) {
+        return false;
+    }
+    EEPROMRead(words, slot * PERSIST_SLOT_BYTES, PERSIST_SLOT_BYTES);
+    if (words[0] != ~words[1]) {
+        return false;
+    }
+    *value = words[0];
+    return true;
+}
+
+
+//Write a slot, blocks for the EEPROM program time so keep it out of ISRs and the control path
+void
+persistWrite (uint8_t slot, uint32_t value)
+{
+    uint32_t words[2];
+
+    if (!persistOk || slot >= NUM_PERSIST_SLOTS) {
+        return;
+    }
+    words[0] = value;
+    words[1] = ~value;
+    EEPROMProgram(words, slot * PERSIST_SLOT_BYTES, PERSIST_SLOT_BYTES);
+}
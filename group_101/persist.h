@@ -0,0 +1,28 @@
+/*
+ * persist.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/eeprom.h"
+
+
+#ifndef PERSIST_H_
+#define PERSIST_H_
+
+// Values kept in EEPROM across resets. Each slot is stored with its complement
+// so an unprogrammed or half written slot reads back as invalid.
+enum persistSlot { PERSIST_YAW_REF = 0, PERSIST_RESET_REASON, PERSIST_HOVER_DUTY, NUM_PERSIST_SLOTS };
+
+void initPersist (void);
+
+bool persistRead (uint8_t slot, uint32_t *value);
+
+void persistWrite (uint8_t slot, uint32_t value);
+
+#endif /* PERSIST_H_ */
@@ -0,0 +1,101 @@
+/*
+ * pid.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "pid.h"
+
+//Tracking gain for back-calculation, none without an integral
+static float
+trackingGain (float kp, float ki)
+{
+    return (kp > 0) ? ki / kp : 0;
+}
+
+
+//Set gains and output limits and clear the state
+void
+pidInit (pidCtrl_t *pid, float kp, float ki, float kd, float outMin, float outMax)
+{
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->kt = trackingGain(kp, ki);
+    pid->outMin = outMin;
+    pid->outMax = outMax;
+    pidReset(pid, 0);
+}
+
+
+//Change the output limits, for limits that move with the operating point
+void
+pidSetLimits (pidCtrl_t *pid, float outMin, float outMax)
+{
+    pid->outMin = outMin;
+    pid->outMax = outMax;
+}
+
+
+// *******************************************************
+// pidSetGains: Switch gain set without a bump. The integral takes up the change in the
+// proportional term at the last error so the next output carries on from the last one.
+// A loop without an integral has nowhere to put it and steps.
+void
+pidSetGains (pidCtrl_t *pid, float kp, float ki, float kd)
+{
+    if (ki > 0) {
+        pid->integral += (pid->kp - kp) * pid->prevError;
+    } else {
+        pid->integral = 0;
+    }
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->kt = trackingGain(kp, ki);
+}
+
+
+//Clear the integral and seed the derivative at the current measurement
+void
+pidReset (pidCtrl_t *pid, float measurement)
+{
+    pid->integral = 0;
+    pid->prevMeasurement = measurement;
+    pid->prevError = 0;
+}
+
+
+// *******************************************************
+// pidUpdate: One step of the loop, dt in seconds. Returns the output clamped to its limits.
+float
+pidUpdate (pidCtrl_t *pid, float setpoint, float measurement, float dt)
+{
+    float error = setpoint - measurement;
+    float P = pid->kp * error;
+    float D = -pid->kd * (measurement - pid->prevMeasurement) / dt;
+    float raw = P + pid->integral + D;
+    float out = raw;
+
+    if (out > pid->outMax) {
+        out = pid->outMax;
+    } else if (out < pid->outMin) {
+        out = pid->outMin;
+    }
+
+    //Back-calculation, the integral is driven back while the output sits on a limit
+    pid->integral += (pid->ki * error + pid->kt * (out - raw)) * dt;
+
+    pid->prevMeasurement = measurement;
+    pid->prevError = error;
+    return out;
+}
+
+
+//Back-calculate from a cut made after the loop, e.g. by the mixer, applied minus requested
+void
+pidTrack (pidCtrl_t *pid, float cut, float dt)
+{
+    pid->integral += pid->kt * cut * dt;
+}
@@ -0,0 +1,44 @@
+/*
+ * pid.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+#ifndef PID_H_
+#define PID_H_
+
+// *******************************************************
+// PID controller state shared by every loop. Derivative acts on the measurement so
+// setpoint steps do not kick. Anti-windup is by back-calculation: the difference between
+// the limited and unlimited output, and any cut made downstream reported through
+// pidTrack(), bleeds out of the integral at kt = ki / kp, a tracking time of Ti.
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+    float kt;               //Back-calculation gain, 1/s
+    float outMin;
+    float outMax;
+    float integral;         //Integral term, in output units
+    float prevMeasurement;
+    float prevError;
+} pidCtrl_t;
+
+void pidInit (pidCtrl_t *pid, float kp, float ki, float kd, float outMin, float outMax);
+
+void pidSetLimits (pidCtrl_t *pid, float outMin, float outMax);
+
+void pidSetGains (pidCtrl_t *pid, float kp, float ki, float kd);
+
+void pidReset (pidCtrl_t *pid, float measurement);
+
+float pidUpdate (pidCtrl_t *pid, float setpoint, float measurement, float dt);
+
+void pidTrack (pidCtrl_t *pid, float cut, float dt);
+
+#endif /* PID_H_ */
@@ -0,0 +1,179 @@
+/*
+ * pwmDriver.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "pwmDriver.h"
+
+//PWM periods in timer ticks, cached at init
+static uint32_t periodMain = 0;
+static uint32_t periodTail = 0;
+static uint32_t cyclesPerUs = 1;
+
+//Duty pair waiting for the next period boundary
+static volatile bool pending = false;
+static volatile uint32_t pendingMain = 0;
+static volatile uint32_t pendingTail = 0;
+static volatile uint32_t requestCycles = 0;
+
+static volatile pwmStats_t pwmStats;
+
+
+/*********************************************************
+ * initialisePWM
+ * M0PWM7 (J4-05, PC5) is used for the main rotor motor
+ * M1PWM5 (J3, PF1) is used for the tail rotor motor
+ * Both generators use globally synchronised updates, new compare values are held until
+ * setDuty() requests a sync and then latch at the next counter zero. The generators run
+ * at the same rate and are enabled back to back so their period boundaries line up.
+ *********************************************************/
+void
+initialisePWM (void)
+{
+    //System clock
+    uint32_t sysClock = SysCtlClockGet();
+
+    //init main
+    SysCtlPeripheralEnable(PWM_MAIN_PERIPH_PWM);
+    SysCtlPeripheralEnable(PWM_MAIN_PERIPH_GPIO);
+
+    GPIOPinConfigure(PWM_MAIN_GPIO_CONFIG);
+    GPIOPinTypePWM(PWM_MAIN_GPIO_BASE, PWM_MAIN_GPIO_PIN);
+
+    PWMGenConfigure(PWM_MAIN_BASE, PWM_MAIN_GEN,
+                    PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_SYNC);
+    // Set the initial PWM parameters
+    periodMain = sysClock / PWM_DIVIDER / PWM_MAIN_FREQ;
+
+    PWMGenPeriodSet(PWM_MAIN_BASE, PWM_MAIN_GEN, periodMain);
+    PWMPulseWidthSet(PWM_MAIN_BASE, PWM_MAIN_OUTNUM, 0);
+    PWMSyncUpdate(PWM_MAIN_BASE, PWM_MAIN_GENBIT);
+
+    // Disable the output.  Repeat this call with 'true' to turn O/P on.
+    PWMOutputState(PWM_MAIN_BASE, PWM_MAIN_OUTBIT, false);
+
+
+    //init Tail
+    SysCtlPeripheralEnable(PWM_TAIL_PERIPH_PWM);
+    SysCtlPeripheralEnable(PWM_TAIL_PERIPH_GPIO);
+
+    GPIOPinConfigure(PWM_TAIL_GPIO_CONFIG);
+    GPIOPinTypePWM(PWM_TAIL_GPIO_BASE, PWM_TAIL_GPIO_PIN);
+
+    PWMGenConfigure(PWM_TAIL_BASE, PWM_TAIL_GEN,
+                    PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_SYNC);
+    // Set the initial PWM parameters
+    // Calculate the PWM period corresponding to the freq.
+    periodTail = sysClock / PWM_DIVIDER / PWM_TAIL_FREQ;
+
+    PWMGenPeriodSet(PWM_TAIL_BASE, PWM_TAIL_GEN, periodTail);
+    PWMPulseWidthSet(PWM_TAIL_BASE, PWM_TAIL_OUTNUM, 0);
+    PWMSyncUpdate(PWM_TAIL_BASE, PWM_TAIL_GENBIT);
+
+    // Disable the output.  Repeat this call with 'true' to turn O/P on.
+    PWMOutputState(PWM_TAIL_BASE, PWM_TAIL_OUTBIT, false);
+
+    //Free running cycle counter for latency timing
+    cyclesPerUs = sysClock / 1000000;
+    HWREG(DEMCR_REG) |= DEMCR_TRCENA;
+    HWREG(DWT_CYCCNT_REG) = 0;
+    HWREG(DWT_CTRL_REG) |= DWT_CTRL_CYCCNTENA;
+
+    pwmStats.latencyMinUs = UINT32_MAX;
+
+    //Main generator counter zero marks each period boundary
+    PWMGenIntRegister(PWM_MAIN_BASE, PWM_MAIN_GEN, PWMPeriodIntHandler);
+    PWMGenIntTrigEnable(PWM_MAIN_BASE, PWM_MAIN_GEN, PWM_INT_CNT_ZERO);
+    PWMIntEnable(PWM_MAIN_BASE, PWM_MAIN_INT);
+
+    //Start both time bases together
+    PWMGenEnable(PWM_MAIN_BASE, PWM_MAIN_GEN);
+    PWMGenEnable(PWM_TAIL_BASE, PWM_TAIL_GEN);
+}
+
+
+
+//Function to set the Main and Tail duty cycles, duty in DUTY_SCALE units of a percent.
+//Both compare values are written then released together, so they latch in the same period.
+//Called from the main loop and the SysTick ISR, so the caller's interrupt mask is restored
+//rather than interrupts being enabled on the way out.
+void
+setDuty (uint32_t mainDuty, uint32_t tailDuty)
+{
+    bool wasMasked = IntMasterDisable();
+
+    PWMPulseWidthSet(PWM_MAIN_BASE, PWM_MAIN_OUTNUM, periodMain * mainDuty / DUTY_PERCENT(100));
+    PWMPulseWidthSet(PWM_TAIL_BASE, PWM_TAIL_OUTNUM, periodTail * tailDuty / DUTY_PERCENT(100));
+
+    PWMSyncUpdate(PWM_MAIN_BASE, PWM_MAIN_GENBIT);
+    PWMSyncUpdate(PWM_TAIL_BASE, PWM_TAIL_GENBIT);
+
+    if (pending) {
+        pwmStats.overwrites++;
+    }
+    pendingMain = mainDuty;
+    pendingTail = tailDuty;
+    requestCycles = HWREG(DWT_CYCCNT_REG);
+    pending = true;
+
+    if (!wasMasked) {
+        IntMasterEnable();
+    }
+}
+
+
+// *******************************************************
+// PWMPeriodIntHandler: Runs at each main generator counter zero. Records the duty pair that
+// took effect this period and how long it waited since setDuty().
+void
+PWMPeriodIntHandler (void)
+{
+    PWMGenIntClear(PWM_MAIN_BASE, PWM_MAIN_GEN, PWM_INT_CNT_ZERO);
+    pwmStats.periods++;
+
+    //Sync request bit clears once the compare values have latched
+    if (pending && !(HWREG(PWM_MAIN_BASE + PWM_O_CTL) & PWM_MAIN_SYNCBIT)) {
+        uint32_t latency = (HWREG(DWT_CYCCNT_REG) - requestCycles) / cyclesPerUs;
+
+        pwmStats.appliedMain = pendingMain;
+        pwmStats.appliedTail = pendingTail;
+        pwmStats.updates++;
+        pwmStats.latencyUs = latency;
+        if (latency < pwmStats.latencyMinUs) {
+            pwmStats.latencyMinUs = latency;
+        }
+        if (latency > pwmStats.latencyMaxUs) {
+            pwmStats.latencyMaxUs = latency;
+        }
+        pending = false;
+    }
+}
+
+
+// *******************************************************
+// getPwmStats: Copy out the actuation stats and start a new min/max latency window.
+// The spread between min and max over a window is the actuation jitter.
+void
+getPwmStats (pwmStats_t *stats)
+{
+    IntMasterDisable();
+    *stats = pwmStats;
+    pwmStats.latencyMinUs = UINT32_MAX;
+    pwmStats.latencyMaxUs = 0;
+    IntMasterEnable();
+}
+
+
+void
+PWM_ON (void) {
+    PWMOutputState(PWM_MAIN_BASE, PWM_MAIN_OUTBIT, true);
+    PWMOutputState(PWM_TAIL_BASE, PWM_TAIL_OUTBIT, true);
+}
+
+void
+PWM_OFF (void) {
+    PWMOutputState(PWM_MAIN_BASE, PWM_MAIN_OUTBIT, false);
+    PWMOutputState(PWM_TAIL_BASE, PWM_TAIL_OUTBIT, false);
+}
@@ -0,0 +1,95 @@
+/*
+ * pwmDriver.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_pwm.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+
+// Duty cycles are carried from the controllers to the PWM in hundredths of a percent,
+// about 7 timer ticks per step at 300 Hz and 20 MHz rather than 667 per whole percent
+#define DUTY_SCALE 100
+#define DUTY_PERCENT(p) ((int32_t) ((p) * DUTY_SCALE))
+
+#define PWM_DIVIDER_CODE   SYSCTL_PWMDIV_1
+#define PWM_DIVIDER        1
+
+//  PWM Hardware Details M0PWM7 (gen 3)
+//  ---Main Rotor PWM: PC5, J4-05
+#define PWM_MAIN_BASE        PWM0_BASE
+#define PWM_MAIN_GEN         PWM_GEN_3
+#define PWM_MAIN_GENBIT      PWM_GEN_3_BIT
+#define PWM_MAIN_INT         PWM_INT_GEN_3
+#define PWM_MAIN_SYNCBIT     PWM_CTL_GLOBALSYNC3
+#define PWM_MAIN_OUTNUM      PWM_OUT_7
+#define PWM_MAIN_OUTBIT      PWM_OUT_7_BIT
+#define PWM_MAIN_PERIPH_PWM  SYSCTL_PERIPH_PWM0
+#define PWM_MAIN_PERIPH_GPIO SYSCTL_PERIPH_GPIOC
+#define PWM_MAIN_GPIO_BASE   GPIO_PORTC_BASE
+#define PWM_MAIN_GPIO_CONFIG GPIO_PC5_M0PWM7
+#define PWM_MAIN_GPIO_PIN    GPIO_PIN_5
+#define PWM_MAIN_FREQ        300
+
+
+//  PWM Hardware Details M1PWM5 (gen 2)
+//  ---Tail Rotor PWM: PF1, J3
+#define PWM_TAIL_BASE        PWM1_BASE
+#define PWM_TAIL_GEN         PWM_GEN_2
+#define PWM_TAIL_GENBIT      PWM_GEN_2_BIT
+#define PWM_TAIL_OUTNUM      PWM_OUT_5
+#define PWM_TAIL_OUTBIT      PWM_OUT_5_BIT
+#define PWM_TAIL_PERIPH_PWM  SYSCTL_PERIPH_PWM1
+#define PWM_TAIL_PERIPH_GPIO SYSCTL_PERIPH_GPIOF
+#define PWM_TAIL_GPIO_BASE   GPIO_PORTF_BASE
+#define PWM_TAIL_GPIO_CONFIG GPIO_PF1_M1PWM5
+#define PWM_TAIL_GPIO_PIN    GPIO_PIN_1
+#define PWM_TAIL_FREQ        300
+
+//Cortex-M4 DWT cycle counter, used to time duty requests to the period they latch in
+#define DEMCR_REG       0xE000EDFC
+#define DEMCR_TRCENA    0x01000000
+#define DWT_CTRL_REG    0xE0001000
+#define DWT_CTRL_CYCCNTENA 0x00000001
+#define DWT_CYCCNT_REG  0xE0001004
+
+
+#ifndef PWMDRIVER_H_
+#define PWMDRIVER_H_
+
+//Actuation timing, latency is from setDuty() to the period boundary both rotors latch on
+typedef struct {
+    uint32_t periods;       //Main PWM periods since start up
+    uint32_t updates;       //Periods that latched a new duty pair
+    uint32_t overwrites;    //Requests replaced before they latched
+    uint32_t appliedMain;   //Duty pair in effect this period, DUTY_SCALE units
+    uint32_t appliedTail;
+    uint32_t latencyUs;     //Last request to latch latency
+    uint32_t latencyMinUs;  //Window since the last getPwmStats()
+    uint32_t latencyMaxUs;
+} pwmStats_t;
+
+void
+initialisePWM (void);
+
+void
+setDuty (uint32_t mainDuty, uint32_t tailDuty);
+
+void PWM_ON (void);
+
+void PWM_OFF (void);
+
+void PWMPeriodIntHandler (void);
+
+void getPwmStats (pwmStats_t *stats);
+
+#endif /* PWMDRIVER_H_ */
@@ -9,69 +9,52 @@
 
 //Heli controller set points
 static int16_t altSetPoint = 0;
-static int16_t yawSetPoint = -223;
+static angle_t yawSetPoint = ANGLE_FROM_COUNTS(INITIAL_YAW_POSITION);
 
 //Altitude ADC Max and Min 
 static uint16_t max_alt = 0; 
 static uint16_t min_alt = 0;
 
-
-
-/*********************************************************
- * initialisePWM
- * M0PWM7 (J4-05, PC5) is used for the main rotor motor
- * M1PWM5 (J3, PF1) is used for the tail rotor motor
- *********************************************************/
-void
-initialisePWM (void)
-{
-    //System clock
-    uint32_t sysClock = SysCtlClockGet();
-
-    //init main
-    SysCtlPeripheralEnable(PWM_MAIN_PERIPH_PWM);
-    SysCtlPeripheralEnable(PWM_MAIN_PERIPH_GPIO);
-
-    GPIOPinConfigure(PWM_MAIN_GPIO_CONFIG);
-    GPIOPinTypePWM(PWM_MAIN_GPIO_BASE, PWM_MAIN_GPIO_PIN);
-
-    PWMGenConfigure(PWM_MAIN_BASE, PWM_MAIN_GEN,
-                    PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_NO_SYNC);
-    // Set the initial PWM parameters
-    uint32_t ui32Period = sysClock / PWM_DIVIDER / PWM_MAIN_FREQ;
-
-    PWMGenPeriodSet(PWM_MAIN_BASE, PWM_MAIN_GEN, ui32Period);
-    PWMPulseWidthSet(PWM_MAIN_BASE, PWM_MAIN_OUTNUM, 0);
-
-    PWMGenEnable(PWM_MAIN_BASE, PWM_MAIN_GEN);
-
-    // Disable the output.  Repeat this call with 'true' to turn O/P on.
-    PWMOutputState(PWM_MAIN_BASE, PWM_MAIN_OUTBIT, false);
-
-
-    //init Tail
-    SysCtlPeripheralEnable(PWM_TAIL_PERIPH_PWM);
-    SysCtlPeripheralEnable(PWM_TAIL_PERIPH_GPIO);
-
-    GPIOPinConfigure(PWM_TAIL_GPIO_CONFIG);
-    GPIOPinTypePWM(PWM_TAIL_GPIO_BASE, PWM_TAIL_GPIO_PIN);
-
-    PWMGenConfigure(PWM_TAIL_BASE, PWM_TAIL_GEN,
-                    PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_NO_SYNC);
-    // Set the initial PWM parameters
-    // Calculate the PWM period corresponding to the freq.
-    uint32_t ui32PeriodTail = sysClock / PWM_DIVIDER / PWM_TAIL_FREQ;
-
-    PWMGenPeriodSet(PWM_TAIL_BASE, PWM_TAIL_GEN, ui32PeriodTail);
-    PWMPulseWidthSet(PWM_TAIL_BASE, PWM_TAIL_OUTNUM, 0);
-
-
-    PWMGenEnable(PWM_TAIL_BASE, PWM_TAIL_GEN);
-
-    // Disable the output.  Repeat this call with 'true' to turn O/P on.
-    PWMOutputState(PWM_TAIL_BASE, PWM_TAIL_OUTBIT, false);
-}
-
+//Altitude loops, heightLoop alone drives thrust when not cascaded
+static pidCtrl_t heightLoop;
+static pidCtrl_t rateLoop;
+static pidCtrl_t *const thrustLoop = ALT_CASCADE ? &rateLoop : &heightLoop;
+
+//Climb rate setpoint from the outer loop, counts/s, and ticks since it last ran
+static float rateSet = 0;
+static uint8_t outerCount = 0;
+
+#if ALT_MPC
+//MPC thrust held between evaluations, percent about hover
+static float mpcThrust = 0;
+#endif
+
+//Thrust loop gain sets, takeoff holds back while the rotor spins up in ground effect
+static const float altGains[NUM_ALT_GAINS][3] = {
+#if ALT_CASCADE
+    { KPV, KIV, KDV },
+    { KPV * ALT_TAKEOFF_KP_SCALE, KIV * ALT_TAKEOFF_KI_SCALE, KDV }
+#else
+    { KPM, KIM, KDM },
+    { KPM * ALT_TAKEOFF_KP_SCALE, KIM * ALT_TAKEOFF_KI_SCALE, KDM }
+#endif
+};
+
+//Tail loops, yawLoop alone drives the tail without the inner rate loop
+static pidCtrl_t yawLoop;
+static pidCtrl_t yawRateLoop;
+static pidCtrl_t *const tailLoop = YAW_RATE_LOOP ? &yawRateLoop : &yawLoop;
+
+//Yaw rate setpoint from the position loop, counts/s, and the inner loop's yaw command
+//now and when controllerTail() last handed it to the mixer, DUTY_SCALE units. All three
+//are shared between the main loop and the SysTick ISR
+static volatile float yawRateSet = 0;
+static volatile int32_t yawCommand = 0;
+static volatile int32_t yawMixed = 0;
+
+//Estimated height above the landed reading and climb rate, ADC counts and counts/s
+static float estHeight = 0;
+static float estRate = 0;
 
 //Initialise min and max ADC heights
 void initAltLimits (uint16_t initLandedADC) {
@@ -79,106 +62,163 @@ void initAltLimits (uint16_t initLandedADC) {
     max_alt = initLandedADC - ADC_STEP_FOR_1V;
 
     altSetPoint = initLandedADC;
+
+    //Thrust limits are set every tick from the hover offset
+#if ALT_CASCADE
+    pidInit(&heightLoop, KPA, 0, 0, -ALT_RATE_MAX, ALT_RATE_MAX);
+#endif
+    pidInit(thrustLoop, altGains[ALT_GAINS_FLIGHT][0], altGains[ALT_GAINS_FLIGHT][1],
+            altGains[ALT_GAINS_FLIGHT][2], 0, 0);
+    estHeight = 0;
+    estRate = 0;
 }
 
 
+//Alpha-beta filter on the altitude mean, the climb rate from a raw difference is all noise
+static void
+altEstimate (uint16_t sensor) {
+    float height = min_alt - sensor;
+    float predicted = estHeight + estRate * DELTA_T;
+    float residual = height - predicted;
+
+    estHeight = predicted + ALT_EST_ALPHA * residual;
+    estRate += ALT_EST_BETA * residual / DELTA_T;
+}
 
-//Function to set the Main and Tail duty cycles
-void
-setDuty (uint32_t mainDuty, uint32_t tailDuty)
-{
-    //Get System clock value once, no point running function all the time
-    static uint32_t sysClock = 0;
-    if (sysClock == 0) {
-        sysClock = SysCtlClockGet();
+
+// *******************************************************
+// controllerMain: Altitude controller, returns a thrust command about hover in DUTY_SCALE
+// units. hover is the mixer's main rotor offset, used to keep the loop inside the duty range.
+// Works in height above landed as the ADC reading falls with height.
+int32_t
+controllerMain (uint16_t sensor, int32_t hover) {
+    float thrustMin = PWM_DUTY_MAIN_MIN - (float)hover / DUTY_SCALE;
+    float thrustMax = PWM_DUTY_MAIN_MAX - (float)hover / DUTY_SCALE;
+    float heightSet = min_alt - altSetPoint;
+    float thrust;
+
+    altEstimate(sensor);
+
+#if ALT_MPC
+    //Explicit MPC on the estimated state at the step it was solved for, the input held in
+    //between as the model assumes. A reset evaluates on the next tick. The table holds the
+    //duty limits about the default hover so only a learned hover offset leaves anything
+    //for the clamp
+    if (outerCount == 0) {
+        mpcThrust = mpcEvaluate(estHeight - heightSet, estRate);
     }
+    if (++outerCount >= MPC_PERIOD_TICKS) {
+        outerCount = 0;
+    }
+    thrust = mpcThrust;
+    if (thrust > thrustMax) {
+        thrust = thrustMax;
+    } else if (thrust < thrustMin) {
+        thrust = thrustMin;
+    }
+#elif ALT_CASCADE
+    //Outer loop at a fifth of the rate, the inner loop has to settle well within its period
+    if (++outerCount >= ALT_OUTER_DIV) {
+        rateSet = pidUpdate(&heightLoop, heightSet, estHeight, DELTA_T * ALT_OUTER_DIV);
+        outerCount = 0;
+    }
+    pidSetLimits(&rateLoop, thrustMin, thrustMax);
+    thrust = pidUpdate(&rateLoop, rateSet, estRate, DELTA_T);
+#else
+    pidSetLimits(&heightLoop, thrustMin, thrustMax);
+    thrust = pidUpdate(&heightLoop, heightSet, min_alt - sensor, DELTA_T);
+#endif
+
+    return DUTY_PERCENT(thrust);
+}
 
-    // Calculate the PWM period corresponding to the freq.
-    uint32_t ui32PeriodMain = sysClock / PWM_DIVIDER / PWM_MAIN_FREQ;
 
-    PWMPulseWidthSet(PWM_MAIN_BASE, PWM_MAIN_OUTNUM, ui32PeriodMain * mainDuty / 100);
+//Back-calculate the thrust loop from the cut made after it, applied minus requested thrust
+//in DUTY_SCALE units from the health limit and the mixer
+void controllerMainTrack (int32_t cut) {
+#if !ALT_MPC
+    pidTrack(thrustLoop, (float) cut / DUTY_SCALE, DELTA_T);
+#endif
+}
 
-    uint32_t ui32PeriodTail = sysClock / PWM_DIVIDER / PWM_TAIL_FREQ;
 
-    PWMPulseWidthSet(PWM_TAIL_BASE, PWM_TAIL_OUTNUM, ui32PeriodTail * tailDuty / 100);
+//Switch the thrust loop gain set without a bump in thrust
+void setAltGains (enum altGainSet set) {
+    pidSetGains(thrustLoop, altGains[set][0], altGains[set][1], altGains[set][2]);
 }
 
 
-//PID controller function for main rotor, returns a duty cycle %
+//Initialise the tail loops, call before the first controller tick
+void initTailLoops (void) {
+#if YAW_RATE_LOOP
+    pidInit(&yawLoop, KPY, 0, 0, -YAW_RATE_MAX, YAW_RATE_MAX);
+    pidInit(&yawRateLoop, KPR, KIR, KDR, PWM_DUTY_TAIL_MIN - PWM_DUTY_TAIL_MAX, PID_TAIL_MAX);
+#else
+    pidInit(&yawLoop, KPT, KIT, KDT, PWM_DUTY_TAIL_MIN - PWM_DUTY_TAIL_MAX, PID_TAIL_MAX);
+#endif
+}
+
+
+// *******************************************************
+// controllerTail: Yaw position loop at the controller rate, returns a yaw command in
+// DUTY_SCALE units. With the rate loop the position loop only sets the rate setpoint and
+// the command is the inner loop's latest output. Gains are tuned in encoder counts on the
+// shortest turn to the setpoint, main rotor torque is cancelled by the mixer.
 int32_t
-controllerMain (uint16_t sensor) {
-    //Record integral and prev sensor value
-    static float dI = 0;
-    static uint16_t prevSensor = 0;
-
-    float error = altSetPoint - sensor;
-    float P = KPM * error;
-    float I = KIM * error * DELTA_T;
-    float D = KDM * (prevSensor - sensor) / DELTA_T;
-
-    //Gravity is constant offset, controller is negative as ADC is opposite to height
-    int32_t control = GRAVITY - P - (dI + I) - D;
-
-    //Cap controller output
-    if (control > PWM_DUTY_MAIN_MAX) {
-        control = PWM_DUTY_MAIN_MAX;
-    } else if (control < PWM_DUTY_MAIN_MIN) {
-        control = PWM_DUTY_MAIN_MIN;
-    } else {
-        //Accumulate integral
-        I = I + dI;
-    }
-    prevSensor = sensor;
-    return control;
+controllerTail (angle_t sensor) {
+    float error = angleToCounts(yawSetPoint - sensor);
+
+#if YAW_RATE_LOOP
+    //The loop sees the shortest turn to the setpoint so it never sees the angle wrap
+    yawRateSet = pidUpdate(&yawLoop, 0, -error, DELTA_T);
+    yawMixed = yawCommand;
+    return yawMixed;
+#else
+    return DUTY_PERCENT(pidUpdate(&yawLoop, 0, -error, DELTA_T));
+#endif
 }
 
 
-//PID controller function for tail rotor, returns a duty cycle %
+// *******************************************************
+// controllerTailRate: Yaw rate inner loop, called every SysTick with the yaw rate in
+// counts/s. Returns the change in the yaw command since controllerTail() last handed it to
+// the mixer, for mixerRemix() to apply between controller ticks.
 int32_t
-controllerTail (int32_t mainControl, int16_t sensor, bool sweepEn) {
-    int16_t error = yawSetPoint - sensor;
-    
-    //Turn off controller wrap around at 180 deg when in take off sweeping mode so sweep can complete 360 turn
-    if (!sweepEn) {
-        //Adjust error values when crossing 180 deg mark
-        if (error < -YAW_ERROR_LIMIT) {
-            error = YAW_REV + error;
-        } else if (error > YAW_ERROR_LIMIT) {
-            error = -YAW_REV + error;
-        }
-    }
-    
-    //Record integral and prev sensor value
-    static float dI = 0;
-    static int16_t prevSensor = 0;
-
-    //PID controller calc
-    float P = KPT * error;
-    float I = KIT * error * DELTA_T;
-    float D = KDT * (prevSensor - sensor) / DELTA_T;
-    float PID_TAIL = P + I + D;
-
-    //Limit PID effort without limiting coupling
-    if (PID_TAIL > PID_TAIL_MAX) {
-        PID_TAIL = PID_TAIL_MAX;
-    }
+controllerTailRate (float rate) {
+#if YAW_RATE_LOOP
+    yawCommand = DUTY_PERCENT(pidUpdate(&yawRateLoop, yawRateSet, rate, DELTA_T_RATE));
+    return yawCommand - yawMixed;
+#else
+    return 0;
+#endif
+}
 
-    //Couple tail rotor to main rotor duty
-    float coupling = mainControl * KC;
 
-    int32_t control = PID_TAIL + coupling;
+//Back-calculate the loop driving the tail from a mixer cut in DUTY_SCALE units. Call from
+//the SysTick ISR with the rate loop, from the controller tick without it.
+void controllerTailTrack (int32_t cut) {
+    pidTrack(tailLoop, (float) cut / DUTY_SCALE, YAW_RATE_LOOP ? DELTA_T_RATE : DELTA_T);
+}
 
-    //Cap controller output
-    if (control > PWM_DUTY_TAIL_MAX) {
-        control = PWM_DUTY_TAIL_MAX;
-    } else if (control < PWM_DUTY_TAIL_MIN) {
-        control = PWM_DUTY_TAIL_MIN;
-    } else {
-        I = I + dI;
-    }
 
-    prevSensor = sensor;
-    return control;
+// *******************************************************
+// controllerReset: Clear every loop integral and seed the derivatives at the current state.
+// Called from updateHelicopterState() on takeoff and touchdown so nothing wound up while
+// landed or learnt on the last flight carries into the next. The yaw rate loop is reset
+// with interrupts masked as it runs in the SysTick ISR.
+void controllerReset (void) {
+    pidReset(&heightLoop, estHeight);
+    pidReset(&rateLoop, estRate);
+    rateSet = 0;
+    outerCount = 0;
+
+    pidReset(&yawLoop, yawLoop.prevMeasurement);
+    IntMasterDisable();
+    pidReset(&yawRateLoop, yawRateLoop.prevMeasurement);
+    yawRateSet = 0;
+    yawCommand = 0;
+    yawMixed = 0;
+    IntMasterEnable();
 }
 
 
@@ -207,26 +247,18 @@ void setAlt (int16_t setPoint) {
 
 //Increase yaw setpoint
 void incYaw (void) {
-    yawSetPoint += YAW_STEP;
-    //special case - wrap around at 180 deg
-    if (yawSetPoint > YAW_ERROR_LIMIT) {
-        yawSetPoint = -YAW_ERROR_LIMIT + (yawSetPoint - YAW_ERROR_LIMIT);
-    }
+    yawSetPoint += ANGLE_FROM_DEG(YAW_STEP_DEG);
 }
 
 
 //Decrease yaw setpoint
 void decYaw (void) {
-    yawSetPoint -= YAW_STEP;
-    //special case - wrap around at 180 deg
-    if (yawSetPoint < -YAW_ERROR_LIMIT) {
-        yawSetPoint = YAW_ERROR_LIMIT + (yawSetPoint + YAW_ERROR_LIMIT);
-    }
+    yawSetPoint -= ANGLE_FROM_DEG(YAW_STEP_DEG);
 }
 
 
 //Set yaw setpoint
-void setYaw (int16_t setPoint) {
+void setYaw (angle_t setPoint) {
     yawSetPoint = setPoint;
 }
 
@@ -236,7 +268,7 @@ int32_t getAltSet (void) {
 }
 
 //Get yaw setpoint
-int32_t getYawSet (void) {
+angle_t getYawSet (void) {
     return yawSetPoint;
 }
 
@@ -251,18 +283,7 @@ uint16_t getmax_alt (void) {
 
 }
 
-
-
-
-
-void 
-PWM_ON (void) {
-    PWMOutputState(PWM_MAIN_BASE, PWM_MAIN_OUTBIT, true);
-    PWMOutputState(PWM_TAIL_BASE, PWM_TAIL_OUTBIT, true);
-}
-
-void 
-PWM_OFF (void) {
-    PWMOutputState(PWM_MAIN_BASE, PWM_MAIN_OUTBIT, false);
-    PWMOutputState(PWM_TAIL_BASE, PWM_TAIL_OUTBIT, false);
+//Get estimated climb rate in tenths of a percent of full height per second
+int32_t getClimbRate (void) {
+    return estRate * 1000 / ADC_STEP_FOR_1V;
 }
@@ -14,18 +14,20 @@
 #include "driverlib/pwm.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
+#include "yawAngle.h"
+#include "pwmDriver.h"
+#include "pid.h"
+#include "mpc.h"
 
 //ALT and YAW
 #define ADC_STEP_FOR_1V 1240
 #define ALT_STEP 124    // 1240/10  For 10% of 1V step
 #define ALT_LAND 24     // 2% of Max height
 #define ALT_TAKEOFF_5_PERCENT 62 //5% of max a
-#define YAW_STEP 19  //448 *15/360 degrees rounded
+#define YAW_STEP_DEG 15  //Yaw setpoint step for LEFT/RIGHT buttons
+#define YAW_SWEEP_LEAD_DEG 30  //Max setpoint lead ahead of yaw while sweeping for the reference
+#define YAW_SWEEP_RATE_DEG 90  //Reference sweep rate, degrees per second
 #define YAW_LIMIT 6     // ~5 degrees
-#define YAW_ERROR_LIMIT 224
-#define YAW_REV 448
-#define GRAVITY 31
-#define KC 0.8
 
 
 
@@ -39,16 +41,45 @@
 #define KIM 0.08
 #define KDM 0.0001
 
+//Cascaded altitude control, the outer height loop commands a climb rate for an inner
+//velocity loop. KPM/KIM/KDM are only used with ALT_CASCADE 0
+#ifndef ALT_CASCADE
+#define ALT_CASCADE 1
+#endif
+#define ALT_OUTER_DIV 5     //Outer loop runs every 5 controller ticks, 50 Hz
+#define KPA 2.0             //Climb rate per count of height error, 1/s
+#define ALT_RATE_MAX 310    //Climb rate limit, ADC counts/s (25% of range per second)
+#define KPV 0.1             //Inner loop, percent duty per count/s of climb rate error,
+#define KIV 0.4             //tuned in test/altStepSim on the MPC plant model
+#define KDV 0
+#define ALT_EST_ALPHA 0.2   //Alpha-beta height and climb rate estimator gains,
+#define ALT_EST_BETA 0.02   //beta = alpha^2 / (2 - alpha) for critical damping
+
+//Thrust loop gains while taking off, scaled from the flight set
+#define ALT_TAKEOFF_KP_SCALE 0.7
+#define ALT_TAKEOFF_KI_SCALE 0.5
+
+//Explicit MPC altitude law from a precomputed table in place of the PID loops
+#define ALT_MPC 0
+
 //TAIL ROTOR
 #define KPT 1.2 //Real rig
 //#define KPT 5
 #define KIT 0.01
 #define KDT 0
 
+//Dual rate tail, the 250 Hz position loop commands a yaw rate for an inner loop run every
+//SysTick on the edge timed rate estimate. KPT/KIT/KDT are only used with YAW_RATE_LOOP 0
+#define YAW_RATE_LOOP 1
+#define DELTA_T_RATE 0.001  //Inner loop period, seconds
+#define KPY 5.0             //Yaw rate per count of yaw error, 1/s
+#define YAW_RATE_MAX 224    //Yaw rate limit, counts/s (180 deg/s)
+#define KPR 0.2             //Inner loop, percent duty per count/s of yaw rate error
+#define KIR 0.5
+#define KDR 0
 
-// PWM configuration
-#define PWM_START_RATE_HZ  250
 
+// PWM configuration
 #define PWM_DUTY_MAIN_MIN   15
 #define PWM_DUTY_MAIN_MAX    80
 #define PWM_DUTY_TAIL_MIN    5
@@ -56,54 +87,33 @@
 #define PID_TAIL_MAX 25
 
 
-#define PWM_DIVIDER_CODE   SYSCTL_PWMDIV_1
-#define PWM_DIVIDER        1
-
-//  PWM Hardware Details M0PWM7 (gen 3)
-//  ---Main Rotor PWM: PC5, J4-05
-#define PWM_MAIN_BASE        PWM0_BASE
-#define PWM_MAIN_GEN         PWM_GEN_3
-#define PWM_MAIN_OUTNUM      PWM_OUT_7
-#define PWM_MAIN_OUTBIT      PWM_OUT_7_BIT
-#define PWM_MAIN_PERIPH_PWM  SYSCTL_PERIPH_PWM0
-#define PWM_MAIN_PERIPH_GPIO SYSCTL_PERIPH_GPIOC
-#define PWM_MAIN_GPIO_BASE   GPIO_PORTC_BASE
-#define PWM_MAIN_GPIO_CONFIG GPIO_PC5_M0PWM7
-#define PWM_MAIN_GPIO_PIN    GPIO_PIN_5
-#define PWM_MAIN_FREQ        300
-
-
-//  PWM Hardware Details M1PWM5 (gen 2)
-//  ---Tail Rotor PWM: PF1, J3
-#define PWM_TAIL_BASE        PWM1_BASE
-#define PWM_TAIL_GEN         PWM_GEN_2
-#define PWM_TAIL_OUTNUM      PWM_OUT_5
-#define PWM_TAIL_OUTBIT      PWM_OUT_5_BIT
-#define PWM_TAIL_PERIPH_PWM  SYSCTL_PERIPH_PWM1
-#define PWM_TAIL_PERIPH_GPIO SYSCTL_PERIPH_GPIOF
-#define PWM_TAIL_GPIO_BASE   GPIO_PORTF_BASE
-#define PWM_TAIL_GPIO_CONFIG GPIO_PF1_M1PWM5
-#define PWM_TAIL_GPIO_PIN    GPIO_PIN_1
-#define PWM_TAIL_FREQ        300
-
-
 
 #ifndef PWMROTOR_H_
 #define PWMROTOR_H_
 
-void
-initialisePWM (void);
+//Thrust loop gain sets
+enum altGainSet { ALT_GAINS_FLIGHT = 0, ALT_GAINS_TAKEOFF, NUM_ALT_GAINS };
 
 void initAltLimits (uint16_t initLandedADC);
 
-void
-setDuty (uint32_t mainDuty, uint32_t tailDuty);
+int32_t
+controllerMain (uint16_t sensor, int32_t hover);
+
+void controllerMainTrack (int32_t cut);
+
+void setAltGains (enum altGainSet set);
 
 int32_t
-controllerMain (uint16_t sensor);
+controllerTail (angle_t sensor);
+
+void initTailLoops (void);
 
 int32_t
-controllerTail (int32_t mainControl, int16_t sensor, bool sweepEn);
+controllerTailRate (float rate);
+
+void controllerTailTrack (int32_t cut);
+
+void controllerReset (void);
 
 void incAlt (void);
 
@@ -115,19 +125,17 @@ void incYaw (void);
 
 void decYaw (void);
 
-void setYaw (int16_t setPoint);
+void setYaw (angle_t setPoint);
 
 int32_t getAltSet (void);
 
-int32_t getYawSet (void);
+angle_t getYawSet (void);
 
 uint16_t getmin_alt (void);
 
 uint16_t getmax_alt (void);
 
-void PWM_ON (void);
-
-void PWM_OFF (void);
+int32_t getClimbRate (void);
 
 #endif /* PWMOTOR_H_ */
 
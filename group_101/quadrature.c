@@ -7,7 +7,15 @@
 
 #include "quadrature.h"
 
-static volatile int32_t yawPosition = INITIAL_YAW_POSITION;
+static volatile angle_t yawPosition = ANGLE_FROM_COUNTS(INITIAL_YAW_POSITION);
+
+//Signed edge count and the DWT cycle count of the last edge, for the rate estimate
+static volatile int32_t edgeCount = 0;
+static volatile uint32_t edgeCycles = 0;
+static uint32_t cyclesPerSec;
+
+//Yaw rate in encoder counts per second
+static float yawRate = 0;
 
 
 
@@ -32,14 +40,22 @@ void initQuad(void)
 
     // Enable interrupts on pins 0 and 1 on GPIO port B, allowing the system to respond to yaw control signals.
     GPIOIntEnable(GPIO_PORTB_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+
+    // Edges are timed on the DWT cycle counter, enabled by initialisePWM()
+    cyclesPerSec = SysCtlClockGet();
+
+    // Seed the sensor snapshot with the assumed start position before any edges arrive
+    publishYaw(yawPosition);
 }
 
 
+//Only called from the yaw reference ISR
 void setYawZero (void) {
     yawPosition = 0;
+    publishYaw(yawPosition);
 }
 
-int32_t getYawPosition (void)
+angle_t getYawPosition (void)
 {
     return yawPosition;
 }
@@ -70,23 +86,61 @@ void GPIOYawHandler(void)
         ((last_state == 0x03) && (state == 0x02)) ||  // Transition from 11 to 10
         ((last_state == 0x02) && (state == 0x00))) {  // Transition from 10 to 00
         // Counter-clockwise rotation: decrement yaw position
-        yawPosition--;
+        yawPosition -= ANGLE_PER_COUNT;
+        edgeCount--;
     } else {
         // Clockwise rotation: Increment yaw position
-        yawPosition++;
-    }
-
-
-    // Handle wrap around at 180 degrees
-    if (yawPosition > WRAPSTEP) {
-        yawPosition = -WRAPSTEP + (yawPosition - WRAPSTEP);
-    }
-    if (yawPosition < -WRAPSTEP) {
-        yawPosition = WRAPSTEP + (yawPosition + WRAPSTEP);
+        yawPosition += ANGLE_PER_COUNT;
+        edgeCount++;
     }
+    edgeCycles = HWREG(DWT_CYCCNT_REG);
+    // Binary angle wraps around at 180 degrees by itself
+    publishYaw(yawPosition);
 
     // Update last_state to the current state for the next interrupt
     last_state = state;
 
 }
 
+
+
+// *******************************************************
+// yawRateUpdate: Called from the SysTick ISR, which shares a priority with GPIOYawHandler so
+// the edge count and time are read together. The rate is the net edges over the time between
+// the last edge of the previous tick and the last edge of this one, which stays accurate from
+// one edge per tick up to full speed. With no new edge the rate can be at most one count over
+// the time since the last edge, so it decays towards zero while the rotor slows.
+void yawRateUpdate (void)
+{
+    static int32_t prevCount = 0;
+    static uint32_t prevCycles = 0;
+    int32_t count = edgeCount;
+    uint32_t cycles = edgeCycles;
+    float rate;
+
+    //Cycle counter reads zero until initialisePWM() starts it
+    if (count != prevCount && cycles != prevCycles) {
+        rate = (float) (count - prevCount) * cyclesPerSec / (cycles - prevCycles);
+        prevCount = count;
+        prevCycles = cycles;
+    } else {
+        uint32_t idle = HWREG(DWT_CYCCNT_REG) - prevCycles;
+        float bound = (float) cyclesPerSec / (idle + 1);
+
+        rate = yawRate;
+        if (idle > cyclesPerSec / 1000 * YAW_RATE_TIMEOUT_MS) {
+            rate = 0;
+        } else if (rate > bound) {
+            rate = bound;
+        } else if (rate < -bound) {
+            rate = -bound;
+        }
+    }
+    yawRate += YAW_RATE_ALPHA * (rate - yawRate);
+}
+
+//Yaw rate in encoder counts per second, positive clockwise
+float getYawRate (void)
+{
+    return yawRate;
+}
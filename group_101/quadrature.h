@@ -17,9 +17,12 @@
 #include "driverlib/interrupt.h"
 #include "driverlib/debug.h"
 #include "utils/ustdlib.h"
+#include "yawAngle.h"
+#include "sensorState.h"
+#include "pwmDriver.h"
 
-#define WRAPSTEP 224 //Number of quadrature steps  before degrees wrap around at +180 and -180 (448/2)
-#define INITIAL_YAW_POSITION -223
+#define YAW_RATE_TIMEOUT_MS 50  //No edge for this long reads as stopped, ~16 deg/s
+#define YAW_RATE_ALPHA 0.3      //Smoothing on the rate estimate, takes the edge off encoder bounce
 
 #ifndef QUADRATURE_H_
 #define QUADRATURE_H_
@@ -29,10 +32,14 @@ void initQuad (void);
 
 void setYawZero (void);
 
-int32_t getYawPosition (void);
+angle_t getYawPosition (void);
 
 void GPIOYawHandler (void);
 
+void yawRateUpdate (void);
+
+float getYawRate (void);
+
 
 
 #endif /* DISPLAY_H_ */
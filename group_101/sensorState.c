@@ -0,0 +1,70 @@
+/*
+ * sensorState.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "sensorState.h"
+
+static volatile sensorState_t sensorState;  //Shared snapshot, written only by ISRs
+static volatile uint32_t tickCount = 0;     //SysTick ticks since reset
+
+
+//Advance the snapshot timestamp clock, called from the SysTick ISR
+void
+sensorTick (void)
+{
+    tickCount++;
+}
+
+//Get SysTick ticks since reset
+uint32_t
+getSensorTick (void)
+{
+    return tickCount;
+}
+
+
+// *******************************************************
+// publishYaw / publishAlt: Called from ISRs only. The ADC, GPIO and SysTick interrupts
+// share one priority so a writer is never preempted by another writer.
+void
+publishYaw (angle_t yaw)
+{
+    sensorState.seq++;
+    sensorState.yaw = yaw;
+    sensorState.timestamp = tickCount;
+    sensorState.seq++;
+}
+
+void
+publishAlt (uint16_t alt)
+{
+    sensorState.seq++;
+    sensorState.alt = alt;
+    sensorState.timestamp = tickCount;
+    sensorState.seq++;
+}
+
+
+// *******************************************************
+// readSensorSnapshot: Copy a consistent snapshot, retrying if an ISR published part way through
+void
+readSensorSnapshot (sensorState_t *snapshot)
+{
+    uint32_t seq;
+
+    do {
+        seq = sensorState.seq;
+        SENSOR_READ_HOOK();
+        snapshot->yaw = sensorState.yaw;
+        SENSOR_READ_HOOK();
+        snapshot->alt = sensorState.alt;
+        SENSOR_READ_HOOK();
+        snapshot->timestamp = sensorState.timestamp;
+        SENSOR_READ_HOOK();
+    } while ((seq & 1) || seq != sensorState.seq);
+
+    snapshot->seq = seq;
+}
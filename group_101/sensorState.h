@@ -0,0 +1,43 @@
+/*
+ * sensorState.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "yawAngle.h"
+
+//Host tests define this to run a publish between the reader's accesses
+#ifndef SENSOR_READ_HOOK
+#define SENSOR_READ_HOOK()
+#endif
+
+
+#ifndef SENSORSTATE_H_
+#define SENSORSTATE_H_
+
+// *******************************************************
+// Sensor snapshot published by the ADC and yaw ISRs. Writers bump seq to odd,
+// update the fields and bump it back to even. Readers retry until they copy
+// the fields between two identical even seq values, so the controller, display
+// and telemetry all see one coherent sample without masking interrupts.
+typedef struct {
+    uint32_t seq;       //Sequence counter, odd while a write is in progress
+    uint32_t timestamp; //SysTick tick of the last update
+    angle_t yaw;        //Yaw position
+    uint16_t alt;       //Mean altitude ADC value
+} sensorState_t;
+
+void sensorTick (void);
+
+uint32_t getSensorTick (void);
+
+void publishYaw (angle_t yaw);
+
+void publishAlt (uint16_t alt);
+
+void readSensorSnapshot (sensorState_t *snapshot);
+
+#endif /* SENSORSTATE_H_ */
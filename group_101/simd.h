@@ -0,0 +1,32 @@
+/*
+ * simd.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+
+
+#ifndef SIMD_H_
+#define SIMD_H_
+
+// *******************************************************
+// Dual 16 bit helpers. On the Cortex-M4 under the TI compiler these are single DSP
+// instructions, elsewhere they fall back to plain C with the same results.
+
+//Pack two int16 into a word, lo in the bottom half
+#define SIMD_PACK2(lo, hi) (((uint32_t) (uint16_t) (lo)) | ((uint32_t) (uint16_t) (hi) << 16))
+
+//Signed dual multiply-accumulate, acc + lo(a)*lo(b) + hi(a)*hi(b)
+#if defined(__TI_ARM__) && defined(__TI_TMS470_V7M4__)
+#define SIMD_MAC2(a, b, acc) _smlad((a), (b), (acc))
+#else
+static inline int32_t
+SIMD_MAC2 (uint32_t a, uint32_t b, int32_t acc)
+{
+    return acc + (int16_t) a * (int16_t) b + (int16_t) (a >> 16) * (int16_t) (b >> 16);
+}
+#endif
+
+#endif /* SIMD_H_ */
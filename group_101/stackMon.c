@@ -0,0 +1,90 @@
+/*
+ * stackMon.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "stackMon.h"
+
+//Linker symbols, see tm4c123gh6pm.cmd. Only their addresses are meaningful.
+extern uint32_t __stack;
+extern uint32_t __STACK_TOP;
+extern uint32_t __vtable_size;
+extern uint32_t __data_size;
+extern uint32_t __bss_size;
+extern uint32_t __sysmem_size;
+
+static uint32_t stackHighWater = 0;   //Most stack ever used in bytes
+static bool stackAlert = false;       //Set once the unused margin drops below STACK_ALERT_MARGIN
+
+
+// *******************************************************
+// paintStack: Fill the unused part of the stack with STACK_PAINT. Call first thing in main(),
+// everything below this function's frame has not been touched yet.
+void
+paintStack (void)
+{
+    volatile uint32_t marker;
+    uint32_t *p = &__stack;
+    uint32_t *end = (uint32_t *) &marker - STACK_PAINT_GUARD;
+
+    while (p < end) {
+        *p++ = STACK_PAINT;
+    }
+}
+
+
+// *******************************************************
+// updateStackMon: Find the lowest word that no longer holds the paint pattern and update the
+// high-water mark and alert. Stack grows down from __STACK_TOP towards __stack.
+void
+updateStackMon (void)
+{
+    uint32_t *p = &__stack;
+
+    while (p < &__STACK_TOP && *p == STACK_PAINT) {
+        p++;
+    }
+
+    stackHighWater = (uint32_t) &__STACK_TOP - (uint32_t) p;
+
+    if (getStackSize() - stackHighWater < STACK_ALERT_MARGIN) {
+        stackAlert = true;
+    }
+}
+
+
+//Get most stack used since reset in bytes
+uint32_t
+getStackHighWater (void)
+{
+    return stackHighWater;
+}
+
+
+//Get stack size in bytes
+uint32_t
+getStackSize (void)
+{
+    return (uint32_t) &__STACK_TOP - (uint32_t) &__stack;
+}
+
+
+//Get SRAM not claimed by the vector table, data, bss, heap or stack in bytes
+uint32_t
+getRamFree (void)
+{
+    uint32_t used = (uint32_t) &__vtable_size + (uint32_t) &__data_size +
+                    (uint32_t) &__bss_size + (uint32_t) &__sysmem_size + getStackSize();
+
+    return SRAM_BYTES - used;
+}
+
+
+//Get stack margin alert, latched until reset
+bool
+getStackAlert (void)
+{
+    return stackAlert;
+}
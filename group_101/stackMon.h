@@ -0,0 +1,32 @@
+/*
+ * stackMon.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "memPlan.h"
+
+#define STACK_PAINT 0xDEADBEEF      //Pattern written over unused stack at reset
+#define STACK_PAINT_GUARD 16        //Words left unpainted below the painting function's frame
+#define STACK_ALERT_MARGIN 96       //Alert when fewer than this many bytes of stack were never used
+
+
+#ifndef STACKMON_H_
+#define STACKMON_H_
+
+void paintStack (void);
+
+void updateStackMon (void);
+
+uint32_t getStackHighWater (void);
+
+uint32_t getStackSize (void);
+
+uint32_t getRamFree (void);
+
+bool getStackAlert (void);
+
+#endif /* STACKMON_H_ */
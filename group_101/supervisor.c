@@ -0,0 +1,138 @@
+/*
+ * supervisor.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "supervisor.h"
+
+static const uint16_t deadline[NUM_SUP_TASKS] = {
+    SUP_DEADLINE_CONTROLLER,
+    SUP_DEADLINE_BUTTONS,
+    SUP_DEADLINE_DISPLAY,
+    SUP_DEADLINE_UART
+};
+
+static const char *SUP_TASK_STRING[NUM_SUP_TASKS] = {
+    "controller",
+    "buttons",
+    "display",
+    "telemetry"
+};
+
+static volatile uint32_t lastCheckIn[NUM_SUP_TASKS];
+static volatile uint8_t missedTasks = 0;    //Bit per task that is past its deadline
+static bool running = false;
+
+//Why the previous run ended
+static bool bootWatchdogReset = false;
+static uint8_t bootMissedTasks = 0;
+
+
+// *******************************************************
+// initSupervisor: Read back why we last reset, then start the watchdog. Call once the main
+// loop is about to start so the start up delay does not count against any task.
+void
+initSupervisor (void)
+{
+    uint32_t reason = 0;
+    uint8_t i;
+
+    if (SysCtlResetCauseGet() & SYSCTL_CAUSE_WDOG0) {
+        bootWatchdogReset = true;
+        if (persistRead(PERSIST_RESET_REASON, &reason)) {
+            bootMissedTasks = reason;
+        }
+    }
+    SysCtlResetCauseClear(SysCtlResetCauseGet());
+    if (reason != 0) {
+        persistWrite(PERSIST_RESET_REASON, 0);
+    }
+
+    for (i = 0; i < NUM_SUP_TASKS; i++) {
+        lastCheckIn[i] = getSensorTick();
+    }
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_WDOG0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_WDOG0)) {
+    }
+    WatchdogReloadSet(WATCHDOG0_BASE, SysCtlClockGet() / 1000 * SUP_WATCHDOG_MS);
+    WatchdogStallEnable(WATCHDOG0_BASE);    //Don't reset while halted in the debugger
+    WatchdogIntRegister(WATCHDOG0_BASE, WatchdogIntHandler);
+    WatchdogResetEnable(WATCHDOG0_BASE);
+    WatchdogEnable(WATCHDOG0_BASE);
+    running = true;
+}
+
+
+//Record that a task has run
+void
+supervisorCheckIn (uint8_t task)
+{
+    lastCheckIn[task] = getSensorTick();
+}
+
+
+// *******************************************************
+// supervisorTick: Called from the SysTick ISR. Feeds the watchdog only if every task has
+// checked in within its deadline, so a hung main loop lets it expire.
+void
+supervisorTick (void)
+{
+    uint32_t now = getSensorTick();
+    uint8_t missed = 0;
+    uint8_t i;
+
+    if (!running) {
+        return;
+    }
+
+    for (i = 0; i < NUM_SUP_TASKS; i++) {
+        if (now - lastCheckIn[i] > deadline[i]) {
+            missed |= 1 << i;
+        }
+    }
+    missedTasks = missed;
+
+    if (missed == 0) {
+        WatchdogIntClear(WATCHDOG0_BASE);   //Clearing the interrupt reloads the counter
+    }
+}
+
+
+// *******************************************************
+// WatchdogIntHandler: First watchdog timeout. Stop the rotors, record which tasks missed and
+// wait for the second timeout to reset the processor.
+void
+WatchdogIntHandler (void)
+{
+    PWM_OFF();
+    persistWrite(PERSIST_RESET_REASON, missedTasks);
+    while (1) {
+    }
+}
+
+
+//True if the last reset was caused by the watchdog
+bool
+getBootWatchdogReset (void)
+{
+    return bootWatchdogReset;
+}
+
+
+//Bit per task that had missed its deadline before the last watchdog reset
+uint8_t
+getBootMissedTasks (void)
+{
+    return bootMissedTasks;
+}
+
+
+//Return task name for reporting
+const char *
+getSupTaskName (uint8_t task)
+{
+    return SUP_TASK_STRING[task];
+}
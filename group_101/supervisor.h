@@ -0,0 +1,48 @@
+/*
+ * supervisor.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/watchdog.h"
+#include "pwmRotor.h"
+#include "persist.h"
+#include "sensorState.h"
+
+//Per task check-in deadlines in ms, a few periods of each task. Telemetry is queued to the
+//UART TX interrupt so nothing in the main loop waits on the serial line.
+#define SUP_DEADLINE_CONTROLLER 20
+#define SUP_DEADLINE_BUTTONS 50
+#define SUP_DEADLINE_DISPLAY 100
+#define SUP_DEADLINE_UART 500
+
+#define SUP_WATCHDOG_MS 1000    //Watchdog interrupt after this long unfed, reset after twice it
+
+
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+//Supervised tasks
+enum supTask { TASK_CONTROLLER = 0, TASK_BUTTONS, TASK_DISPLAY, TASK_UART, NUM_SUP_TASKS };
+
+void initSupervisor (void);
+
+void supervisorCheckIn (uint8_t task);
+
+void supervisorTick (void);
+
+void WatchdogIntHandler (void);
+
+bool getBootWatchdogReset (void);
+
+uint8_t getBootMissedTasks (void);
+
+const char *getSupTaskName (uint8_t task);
+
+#endif /* SUPERVISOR_H_ */
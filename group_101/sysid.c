@@ -0,0 +1,224 @@
+/*
+ * sysid.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <math.h>
+#include "sysid.h"
+
+#define SYSID_TICK_MS (1000 / SYSID_RATE_HZ)
+#define TWO_PI_F 6.2831853f
+
+static sysidSample_t sysidLogBuf[SYSID_LOG_LEN];
+static uint16_t logLen = 0;
+static uint16_t dumpIndex = 0;
+static bool dumping = false;
+
+//Run settings, set by the SI command
+static uint8_t axis = SYSID_MAIN;
+static uint8_t waveform = SYSID_PRBS;
+static int32_t amplitude = 0;       //DUTY_SCALE units
+static uint16_t runTicks = 0;       //Controller ticks to excite for
+
+static bool armed = false;
+static bool running = false;
+static uint16_t tick = 0;
+static bool overrun = false;
+static uint32_t lastLogTick = 0;
+static uint16_t lfsr = 0x1FF;       //9 bit PRBS, x^9 + x^5 + 1, period 511 bits
+static uint32_t phase = 0;          //Chirp phase, 2^32 per cycle
+
+
+//Next excitation value in DUTY_SCALE units
+static int32_t
+excitation (void)
+{
+    if (waveform == SYSID_PRBS) {
+        if (tick % SYSID_PRBS_HOLD == 0) {
+            uint16_t bit = ((lfsr >> 8) ^ (lfsr >> 4)) & 1;
+            lfsr = ((lfsr << 1) | bit) & 0x1FF;
+        }
+        return (lfsr & 1) ? amplitude : -amplitude;
+    }
+
+    uint32_t freq = SYSID_CHIRP_F0_MHZ +
+                    (uint32_t) (SYSID_CHIRP_F1_MHZ - SYSID_CHIRP_F0_MHZ) * tick / runTicks;
+    phase += (uint64_t) freq * 4294967296u / (SYSID_RATE_HZ * 1000);
+    return amplitude * sinf(phase * (TWO_PI_F / 4294967296.0f));
+}
+
+
+// *******************************************************
+// sysidCommand: Handle a UART command line, returns false if it was not understood.
+//   SI <M|T> <P|C> amp% ms    arm a PRBS or chirp run on the main or tail rotor, runs from FLYING
+//   SX                        abort
+//   SD                        send the log of the last run
+bool
+sysidCommand (const char *line)
+{
+    if (line[0] != 'S') {
+        return false;
+    }
+
+    switch (line[1]) {
+        case 'X':
+            sysidAbort();
+            return true;
+        case 'D':
+            if (running) {
+                return false;
+            }
+            dumpIndex = 0;
+            dumping = true;
+            return true;
+        case 'I':
+        {
+            int32_t amp, ms;
+            const char *p = line + 2;
+
+            if (running) {
+                return false;
+            }
+            while (*p == ' ') {
+                p++;
+            }
+            switch (*p++) {
+                case 'M': axis = SYSID_MAIN; break;
+                case 'T': axis = SYSID_TAIL; break;
+                default: return false;
+            }
+            while (*p == ' ') {
+                p++;
+            }
+            switch (*p++) {
+                case 'P': waveform = SYSID_PRBS; break;
+                case 'C': waveform = SYSID_CHIRP; break;
+                default: return false;
+            }
+            if (!(p = parseInt(p, &amp)) || !(p = parseInt(p, &ms))) {
+                return false;
+            }
+            if (amp <= 0 || amp > SYSID_AMP_MAX || ms <= 0) {
+                return false;
+            }
+            if (ms > SYSID_LOG_LEN * 1000 / SYSID_RATE_HZ) {
+                ms = SYSID_LOG_LEN * 1000 / SYSID_RATE_HZ;
+            }
+            amplitude = DUTY_PERCENT(amp);
+            runTicks = ms * SYSID_RATE_HZ / 1000;
+            armed = runTicks > 0;
+            return armed;
+        }
+        default:
+            return false;
+    }
+}
+
+
+//Called each FLYING tick, starts an armed run from the current hover
+void
+sysidStartIfArmed (void)
+{
+    if (armed && !running) {
+        armed = false;
+        running = true;
+        dumping = false;
+        overrun = false;
+        logLen = 0;
+        tick = 0;
+        lfsr = 0x1FF;
+        phase = 0;
+    }
+}
+
+
+//Stop exciting, the log so far is kept
+void
+sysidAbort (void)
+{
+    armed = false;
+    running = false;
+}
+
+
+bool
+sysidRunning (void)
+{
+    return running;
+}
+
+
+//Add the excitation to the thrust or yaw command, called every controller tick before mixing
+void
+sysidExcite (int32_t command[NUM_AXES])
+{
+    if (!running) {
+        return;
+    }
+    command[axis == SYSID_MAIN ? AXIS_THRUST : AXIS_YAW] += excitation();
+}
+
+
+// *******************************************************
+// sysidLog: Log the applied duty and the response, called every controller tick after
+// mixing. The fit assumes samples exactly one controller tick apart, so a missed tick ends
+// the run and the log keeps only the samples before the gap.
+void
+sysidLog (const int32_t duty[NUM_ACTUATORS], uint16_t alt, angle_t yaw)
+{
+    uint32_t now = getSensorTick();
+
+    if (!running) {
+        return;
+    }
+
+    //The loop picks a tick up within a millisecond, anything later is a lost tick
+    if (logLen > 0 && now - lastLogTick > SYSID_TICK_MS + SYSID_TICK_MS / 2) {
+        overrun = true;
+        running = false;
+        return;
+    }
+    lastLogTick = now;
+
+    sysidSample_t *sample = &sysidLogBuf[logLen++];
+    if (axis == SYSID_MAIN) {
+        sample->input = duty[ACT_MAIN];
+        sample->output = alt;
+    } else {
+        sample->input = duty[ACT_TAIL];
+        sample->output = angleToCounts(yaw);
+    }
+
+    tick++;
+    if (tick >= runTicks) {
+        running = false;
+    }
+}
+
+
+//Hand the next log entry to telemetry after an SD command, false when there is none
+bool
+sysidNextSample (uint16_t *index, sysidSample_t *sample)
+{
+    if (!dumping || dumpIndex >= logLen) {
+        dumping = false;
+        return false;
+    }
+    *index = dumpIndex;
+    *sample = sysidLogBuf[dumpIndex++];
+    return true;
+}
+
+
+//Settings and outcome of the last run
+void
+getSysidRun (sysidRun_t *run)
+{
+    run->axis = axis;
+    run->waveform = waveform;
+    run->amplitude = amplitude;
+    run->samples = logLen;
+    run->overrun = overrun;
+}
@@ -0,0 +1,65 @@
+/*
+ * sysid.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "memPlan.h"
+#include "yawAngle.h"
+#include "pwmRotor.h"
+#include "mixer.h"
+#include "fastFmt.h"
+#include "sensorState.h"
+
+#define SYSID_AMP_MAX 15            //Largest excitation, percent duty
+#define SYSID_PRBS_HOLD 5           //Controller ticks per PRBS bit, 20 ms
+#define SYSID_CHIRP_F0_MHZ 100      //Chirp sweeps linearly from 0.1 Hz
+#define SYSID_CHIRP_F1_MHZ 5000     //to 5 Hz over the run
+#define SYSID_RATE_HZ 250           //Controller rate the log is taken at
+#define SYSID_DUMP_LINES 8          //Log lines sent per telemetry update, ~170 ms of UART
+
+
+#ifndef SYSID_H_
+#define SYSID_H_
+
+enum sysidAxis { SYSID_MAIN = 0, SYSID_TAIL };
+enum sysidSignal { SYSID_PRBS = 0, SYSID_CHIRP };
+
+// *******************************************************
+// One log entry per controller tick. Input is the duty applied to the excited rotor in
+// DUTY_SCALE units, output is the altitude ADC mean for the main rotor or the yaw in
+// encoder counts for the tail.
+typedef struct {
+    int16_t input;
+    int16_t output;
+} sysidSample_t;
+
+bool sysidCommand (const char *line);
+
+void sysidStartIfArmed (void);
+
+void sysidAbort (void);
+
+bool sysidRunning (void);
+
+void sysidExcite (int32_t command[NUM_AXES]);
+
+void sysidLog (const int32_t duty[NUM_ACTUATORS], uint16_t alt, angle_t yaw);
+
+//Settings and outcome of the last run, for the log header
+typedef struct {
+    uint8_t axis;
+    uint8_t waveform;
+    int32_t amplitude;      //DUTY_SCALE units
+    uint16_t samples;
+    bool overrun;           //Stopped early because a controller tick was missed
+} sysidRun_t;
+
+bool sysidNextSample (uint16_t *index, sysidSample_t *sample);
+
+void getSysidRun (sysidRun_t *run);
+
+#endif /* SYSID_H_ */
@@ -0,0 +1,20 @@
+/*
+ * acqClock.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// The ADC path built for clock triggered acquisition, renamed so noiseSim can link it
+// alongside the PWM synchronised build in acqPwm.c.
+
+#define ALT_ACQ_PWM_SYNC 0
+#define initADC clockInitADC
+#define ADCIntHandler clockADCIntHandler
+#define ADC1IntHandler clockADC1IntHandler
+#define getAltMean clockGetAltMean
+#define getSpikeCount clockGetSpikeCount
+#define getAltRawChanges clockGetAltRawChanges
+
+#include "../ADC.c"
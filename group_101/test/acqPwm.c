@@ -0,0 +1,20 @@
+/*
+ * acqPwm.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// The ADC path built for PWM synchronised acquisition, renamed so noiseSim can link it
+// alongside the clock triggered build in acqClock.c.
+
+#define ALT_ACQ_PWM_SYNC 1
+#define initADC pwmInitADC
+#define ADCIntHandler pwmADCIntHandler
+#define ADC1IntHandler pwmADC1IntHandler
+#define getAltMean pwmGetAltMean
+#define getSpikeCount pwmGetSpikeCount
+#define getAltRawChanges pwmGetAltRawChanges
+
+#include "../ADC.c"
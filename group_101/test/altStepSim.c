@@ -0,0 +1,199 @@
+/*
+ * altStepSim.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Altitude step response of the cascaded loops against the single PID. Both builds of
+// pwmRotor.c fly the same plant through the same height steps and the rise time, overshoot
+// and settling time of each are compared.
+//
+// The plant is the model the MPC table is solved for, climb rate v' = -ALT_PLANT_A v +
+// ALT_PLANT_B u with u the thrust in percent about the true hover. The mixer's hover
+// estimate is off by SIM_HOVER_ERROR so the integrals have work to do. The controller
+// reads the height through a SIM_SENSOR_LAG mean and rounds it to whole ADC counts, and
+// runs every DELTA_T against a plant stepped each millisecond.
+//
+// Run with --plant plant.txt to fly a main axis model fitted by tools/sysidFit.py instead.
+
+#include <math.h>
+#include "hostTest.h"
+#include "../pwmRotor.h"
+
+#define CTRL_DECLARE(prefix) \
+    void prefix##_initAltLimits (uint16_t initLandedADC); \
+    int32_t prefix##_controllerMain (uint16_t sensor, int32_t hover); \
+    void prefix##_setAlt (int16_t setPoint);
+
+CTRL_DECLARE(cascade)
+CTRL_DECLARE(single)
+
+#define ALT_PLANT_A 2.0             //Climb rate pole, 1/s
+#define ALT_PLANT_B 40.0            //Climb acceleration, counts/s^2 per percent
+#define SIM_LANDED 2500             //Landed ADC reading
+#define SIM_HOVER 31.0              //True hover duty, percent
+#define SIM_HOVER_ERROR 2.0         //Mixer hover estimate below the truth, percent
+#define SIM_SENSOR_LAG 30           //Altitude mean length, ms
+#define SIM_SETTLE_BAND 0.02        //Settled within this fraction of the step
+#define SIM_STEP_TIME 8.0           //Time allowed for each step, s
+#define SIM_TICKS (int) (DELTA_T * 1000 + 0.5)
+
+//Plant model in use
+static double plantA = ALT_PLANT_A;
+static double plantB = ALT_PLANT_B;
+
+//One controller build behind function pointers
+typedef struct {
+    const char *name;
+    void (*initAltLimits) (uint16_t initLandedADC);
+    int32_t (*controllerMain) (uint16_t sensor, int32_t hover);
+    void (*setAlt) (int16_t setPoint);
+} ctrl_t;
+
+static const ctrl_t cascade = { "cascade", cascade_initAltLimits, cascade_controllerMain,
+                                cascade_setAlt };
+static const ctrl_t single = { "single PID", single_initAltLimits, single_controllerMain,
+                               single_setAlt };
+
+//Plant state, height above landed in ADC counts, and the sensor mean
+typedef struct {
+    double height;
+    double rate;
+    double history[SIM_SENSOR_LAG];
+    uint32_t ms;
+} plant_t;
+
+//Step response figures, seconds and fraction of the step
+typedef struct {
+    double rise;
+    double overshoot;
+    double settle;
+} response_t;
+
+static void
+plantStep (plant_t *p, double thrust)
+{
+    double dt = 0.001;
+
+    p->rate += (-plantA * p->rate + plantB * thrust) * dt;
+    p->height += p->rate * dt;
+    if (p->height < 0) {
+        p->height = 0;
+        p->rate = 0;
+    }
+    p->history[p->ms++ % SIM_SENSOR_LAG] = p->height;
+}
+
+static uint16_t
+sensor (const plant_t *p)
+{
+    double sum = 0;
+    uint8_t i;
+
+    for (i = 0; i < SIM_SENSOR_LAG; i++) {
+        sum += p->history[i];
+    }
+    return lround(SIM_LANDED - sum / SIM_SENSOR_LAG);
+}
+
+// *******************************************************
+// flyStep: Fly from the present height to target counts above landed and measure the
+// response, rise from 10% to 90% of the step and settling into SIM_SETTLE_BAND. A step that
+// never settles reports the whole SIM_STEP_TIME.
+static response_t
+flyStep (const ctrl_t *c, plant_t *p, double target)
+{
+    double start = p->height;
+    double step = target - start;
+    double tenth = start + 0.1 * step;
+    double ninetieth = start + 0.9 * step;
+    double riseStart = -1;
+    double thrust = 0;
+    response_t r = { -1, 0, 0 };
+    uint32_t ms;
+
+    c->setAlt(SIM_LANDED - target);
+    for (ms = 0; ms < SIM_STEP_TIME * 1000; ms++) {
+        double t = ms / 1000.0;
+        double progress = (p->height - start) / step;
+
+        if (ms % SIM_TICKS == 0) {
+            int32_t hover = DUTY_PERCENT(SIM_HOVER - SIM_HOVER_ERROR);
+            thrust = (double) c->controllerMain(sensor(p), hover) / DUTY_SCALE - SIM_HOVER_ERROR;
+        }
+        plantStep(p, thrust);
+
+        if (riseStart < 0 && (p->height - tenth) * step >= 0) {
+            riseStart = t;
+        }
+        if (r.rise < 0 && (p->height - ninetieth) * step >= 0) {
+            r.rise = t - riseStart;
+        }
+        if (progress - 1 > r.overshoot) {
+            r.overshoot = progress - 1;
+        }
+        if (fabs(progress - 1) > SIM_SETTLE_BAND) {
+            r.settle = t;
+        }
+    }
+    return r;
+}
+
+//Hover settled at start counts then fly each step, returns the worst of each figure
+static response_t
+flySteps (const ctrl_t *c, double start, const double *targets, uint8_t n)
+{
+    plant_t p = { 0 };
+    response_t worst = { 0, 0, 0 };
+    uint8_t i;
+
+    c->initAltLimits(SIM_LANDED);
+    flyStep(c, &p, start);
+    for (i = 0; i < n; i++) {
+        response_t r = flyStep(c, &p, targets[i]);
+        printf("  %-12s %4.0f to %4.0f   rise %5.2f s  overshoot %5.1f%%  ",
+               c->name, i ? targets[i - 1] : start, targets[i], r.rise, 100 * r.overshoot);
+        if (r.settle < SIM_STEP_TIME - 0.01) {
+            printf("settle %5.2f s\n", r.settle);
+        } else {
+            printf("not settled\n");
+        }
+        if (r.rise < 0 || r.rise > worst.rise) {
+            worst.rise = r.rise < 0 ? SIM_STEP_TIME : r.rise;
+        }
+        worst.overshoot = fmax(worst.overshoot, r.overshoot);
+        worst.settle = fmax(worst.settle, r.settle);
+    }
+    return worst;
+}
+
+
+int
+main (int argc, char **argv)
+{
+    //Button steps of ALT_STEP up and down, then a half range climb and descent
+    static const double targets[] = { 248 + ALT_STEP, 248, 868, 248 };
+    uint8_t n = sizeof(targets) / sizeof(targets[0]);
+    response_t singleWorst, cascadeWorst;
+
+    if (!hostReadPlant(argc, argv, "main", &plantA, &plantB)) {
+        return 1;
+    }
+    printf("altitude steps, counts above landed\n");
+    singleWorst = flySteps(&single, 248, targets, n);
+    cascadeWorst = flySteps(&cascade, 248, targets, n);
+    printf("  worst case   single PID rise %.2f s overshoot %.1f%% settle %.2f s\n",
+           singleWorst.rise, 100 * singleWorst.overshoot, singleWorst.settle);
+    printf("               cascade    rise %.2f s overshoot %.1f%% settle %.2f s\n",
+           cascadeWorst.rise, 100 * cascadeWorst.overshoot, cascadeWorst.settle);
+
+    CHECK(cascadeWorst.rise < singleWorst.rise, "cascade rise %.2f s not faster than %.2f s",
+          cascadeWorst.rise, singleWorst.rise);
+    CHECK(cascadeWorst.settle < singleWorst.settle, "cascade settle %.2f s not faster than %.2f s",
+          cascadeWorst.settle, singleWorst.settle);
+    CHECK(cascadeWorst.overshoot < 0.1, "cascade overshoot %.1f%%", 100 * cascadeWorst.overshoot);
+
+    return hostResult("altStepSim");
+}
@@ -0,0 +1,219 @@
+/*
+ * biquadTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Frequency response of the altitude pre-filter, the fixed point cascade built by
+// initADC() from the ADC.h settings. Sine inputs at a range of frequencies are run through
+// biquadCascade() and the output amplitude measured by correlation, then compared with the
+// floating point design. Also checks DC gain, quiet settling and saturation, and times the
+// cascade against a float direct form I of the same filters.
+
+#include <math.h>
+#include "hostTest.h"
+#include "../biquad.c"
+#include "../ADC.h"
+
+#define FS ((float) ALT_SAMPLE_RATE_HZ)
+#define BASE (2048 << ALT_FILTER_SHIFT)     //Mid scale, as the filter sees it
+#define AMPLITUDE (400 << ALT_FILTER_SHIFT)
+#define BENCH_SAMPLES 2000000
+
+//Float coefficients of one section, normalised so a0 = 1
+typedef struct {
+    double b0, b1, b2, a1, a2;
+    double x1, x2, y1, y2;
+} floatSection_t;
+
+static void
+floatNotch (floatSection_t *s, double f, double q)
+{
+    double w0 = 2 * M_PI * f / FS;
+    double alpha = sin(w0) / (2 * q);
+    double a0 = 1 + alpha;
+    *s = (floatSection_t) { 1 / a0, -2 * cos(w0) / a0, 1 / a0, -2 * cos(w0) / a0,
+                            (1 - alpha) / a0, 0, 0, 0, 0 };
+}
+
+static void
+floatLowPass (floatSection_t *s, double f, double q)
+{
+    double w0 = 2 * M_PI * f / FS;
+    double alpha = sin(w0) / (2 * q);
+    double a0 = 1 + alpha;
+    double c = cos(w0);
+    *s = (floatSection_t) { (1 - c) / 2 / a0, (1 - c) / a0, (1 - c) / 2 / a0, -2 * c / a0,
+                            (1 - alpha) / a0, 0, 0, 0, 0 };
+}
+
+//Designed gain of the cascade at f, dB
+static double
+designGainDb (const floatSection_t *s, uint8_t count, double f)
+{
+    double w = 2 * M_PI * f / FS;
+    double gain = 1;
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        double nr = s[i].b0 + s[i].b1 * cos(w) + s[i].b2 * cos(2 * w);
+        double ni = -s[i].b1 * sin(w) - s[i].b2 * sin(2 * w);
+        double dr = 1 + s[i].a1 * cos(w) + s[i].a2 * cos(2 * w);
+        double di = -s[i].a1 * sin(w) - s[i].a2 * sin(2 * w);
+        gain *= sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+    }
+    return 20 * log10(gain);
+}
+
+static float
+floatCascade (floatSection_t *s, uint8_t count, float x)
+{
+    uint8_t i;
+    for (i = 0; i < count; i++) {
+        double y = s[i].b0 * x + s[i].b1 * s[i].x1 + s[i].b2 * s[i].x2 -
+                   s[i].a1 * s[i].y1 - s[i].a2 * s[i].y2;
+        s[i].x2 = s[i].x1;
+        s[i].x1 = x;
+        s[i].y2 = s[i].y1;
+        s[i].y1 = y;
+        x = y;
+    }
+    return x;
+}
+
+//The filter bank as initADC() sets it up
+static void
+initFilters (biquad_t *q, floatSection_t *f)
+{
+    biquadNotch(&q[0], ALT_NOTCH_HZ, ALT_NOTCH_Q, FS);
+    biquadLowPass(&q[1], ALT_LOWPASS_HZ, ALT_LOWPASS_Q, FS);
+    biquadReset(&q[0], BASE);
+    biquadReset(&q[1], BASE);
+    floatNotch(&f[0], ALT_NOTCH_HZ, ALT_NOTCH_Q);
+    floatLowPass(&f[1], ALT_LOWPASS_HZ, ALT_LOWPASS_Q);
+}
+
+//Measured gain of the fixed point cascade at f, dB, by correlating over whole cycles
+static double
+measureGainDb (double f)
+{
+    biquad_t q[ALT_BIQUAD_SECTIONS];
+    floatSection_t unused[ALT_BIQUAD_SECTIONS];
+    uint32_t settle = (uint32_t) (FS / 2);          //0.5 s, far longer than any pole
+    uint32_t cycles = (uint32_t) ceil(f / 2) + 4;
+    uint32_t n = (uint32_t) lround(cycles * FS / f);
+    double i = 0;
+    double qd = 0;
+    uint32_t k;
+
+    initFilters(q, unused);
+    for (k = 0; k < settle + n; k++) {
+        double phase = 2 * M_PI * f * k / FS;
+        int16_t x = BASE + lround(AMPLITUDE * sin(phase));
+        int16_t y = biquadCascade(q, ALT_BIQUAD_SECTIONS, x);
+        if (k >= settle) {
+            i += (y - BASE) * sin(phase);
+            qd += (y - BASE) * cos(phase);
+        }
+    }
+    double amplitude = 2 * sqrt(i * i + qd * qd) / n;
+    return 20 * log10(amplitude / AMPLITUDE);
+}
+
+
+int
+main (void)
+{
+    static const double freqs[] = { 1, 5, 10, 20, 30, 40, 45, 50, 55, 60, 80, 100, 150,
+                                    300, 600, 900 };
+    biquad_t q[ALT_BIQUAD_SECTIONS];
+    floatSection_t f[ALT_BIQUAD_SECTIONS];
+    uint32_t i;
+
+    initFilters(q, f);
+
+    //Response against the design
+    printf("  Hz   design dB  measured dB\n");
+    for (i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++) {
+        double design = designGainDb(f, ALT_BIQUAD_SECTIONS, freqs[i]);
+        double measured = measureGainDb(freqs[i]);
+        printf("%5.0f  %9.2f  %11.2f\n", freqs[i], design, measured);
+        if (design > -40) {
+            CHECK(fabs(measured - design) < 0.5, "%.0f Hz: %.2f dB, designed %.2f dB",
+                  freqs[i], measured, design);
+        } else {
+            CHECK(measured < -35, "%.0f Hz: only %.2f dB down, designed %.2f dB",
+                  freqs[i], measured, design);
+        }
+    }
+    CHECK(fabs(measureGainDb(1)) < 0.1, "passband not flat at 1 Hz");
+    CHECK(measureGainDb(ALT_NOTCH_HZ) < -30, "notch less than 30 dB deep");
+    CHECK(measureGainDb(PWM_MAIN_FREQ) < -30, "PWM frequency less than 30 dB down");
+
+    //DC gain is exact, a held input comes out unchanged with no limit cycle
+    for (i = 0; i <= 4095; i += 455) {
+        int16_t x = i << ALT_FILTER_SHIFT;
+        int16_t y = 0;
+        int16_t yMin = INT16_MAX;
+        int16_t yMax = INT16_MIN;
+        uint32_t k;
+        initFilters(q, f);
+        biquadReset(&q[0], 0);
+        biquadReset(&q[1], 0);
+        for (k = 0; k < 4000; k++) {
+            y = biquadCascade(q, ALT_BIQUAD_SECTIONS, x);
+            if (k >= 3000) {
+                yMin = y < yMin ? y : yMin;
+                yMax = y > yMax ? y : yMax;
+            }
+        }
+        CHECK(yMin == x && yMax == x, "held %d settles to %d..%d", x, yMin, yMax);
+    }
+
+    //Full range ADC steps keep clear of the int16 limits, notch ringing included
+    initFilters(q, f);
+    int16_t yMin = INT16_MAX;
+    int16_t yMax = INT16_MIN;
+    for (i = 0; i < 8000; i++) {
+        int16_t x = (i / 400) & 1 ? 4095 << ALT_FILTER_SHIFT : 0;
+        int16_t y = biquadCascade(q, ALT_BIQUAD_SECTIONS, x);
+        yMin = y < yMin ? y : yMin;
+        yMax = y > yMax ? y : yMax;
+    }
+    printf("biquad: full range ADC steps ring to %d..%d of 0..%d\n", yMin, yMax,
+           4095 << ALT_FILTER_SHIFT);
+    CHECK(yMax < INT16_MAX * 3 / 4 && yMin > INT16_MIN * 3 / 4,
+          "under a quarter scale headroom, %d..%d", yMin, yMax);
+
+    //Steps past the headroom saturate rather than wrap through zero
+    initFilters(q, f);
+    yMin = INT16_MAX;
+    for (i = 0; i < 8000; i++) {
+        int16_t y = biquadCascade(q, ALT_BIQUAD_SECTIONS, (i / 400) & 1 ? INT16_MAX : 0);
+        yMin = y < yMin ? y : yMin;
+    }
+    CHECK(yMin > INT16_MIN / 4, "saturated steps wrapped to %d", yMin);
+
+    //Cost per sample against a float direct form I of the same cascade
+    volatile int16_t sink = 0;
+    volatile float fsink = 0;
+    uint64_t start = hostNs();
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        sink = biquadCascade(q, ALT_BIQUAD_SECTIONS, BASE + (i & 255));
+    }
+    uint64_t fixedNs = hostNs() - start;
+    start = hostNs();
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        fsink = floatCascade(f, ALT_BIQUAD_SECTIONS, BASE + (i & 255));
+    }
+    uint64_t floatNs = hostNs() - start;
+    (void) sink;
+    (void) fsink;
+    printf("biquad: %d sections, %.1f ns/sample fixed point, %.1f ns/sample float (host)\n",
+           ALT_BIQUAD_SECTIONS, (double) fixedNs / BENCH_SAMPLES,
+           (double) floatNs / BENCH_SAMPLES);
+
+    return hostResult("biquadTest");
+}
@@ -0,0 +1,15 @@
+/*
+ * ctrlCascade.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// The controller built with the cascaded altitude loops, as cascade_name for altStepSim.
+
+#define ALT_CASCADE 1
+#define CTRL_PREFIX cascade
+#include "ctrlRename.h"
+
+#include "../pwmRotor.c"
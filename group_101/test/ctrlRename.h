@@ -0,0 +1,39 @@
+/*
+ * ctrlRename.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Renames every function pwmRotor.c exports to CTRL_PREFIX_name, so builds of the
+// controller with different options can link into one program. Define CTRL_PREFIX first.
+
+#ifndef CTRLRENAME_H_
+#define CTRLRENAME_H_
+
+#define CTRL_PASTE(prefix, name) prefix##_##name
+#define CTRL_NAME(prefix, name) CTRL_PASTE(prefix, name)
+
+#define initAltLimits       CTRL_NAME(CTRL_PREFIX, initAltLimits)
+#define controllerMain      CTRL_NAME(CTRL_PREFIX, controllerMain)
+#define controllerMainTrack CTRL_NAME(CTRL_PREFIX, controllerMainTrack)
+#define setAltGains         CTRL_NAME(CTRL_PREFIX, setAltGains)
+#define controllerTail      CTRL_NAME(CTRL_PREFIX, controllerTail)
+#define initTailLoops       CTRL_NAME(CTRL_PREFIX, initTailLoops)
+#define controllerTailRate  CTRL_NAME(CTRL_PREFIX, controllerTailRate)
+#define controllerTailTrack CTRL_NAME(CTRL_PREFIX, controllerTailTrack)
+#define controllerReset     CTRL_NAME(CTRL_PREFIX, controllerReset)
+#define incAlt              CTRL_NAME(CTRL_PREFIX, incAlt)
+#define decAlt              CTRL_NAME(CTRL_PREFIX, decAlt)
+#define setAlt              CTRL_NAME(CTRL_PREFIX, setAlt)
+#define incYaw              CTRL_NAME(CTRL_PREFIX, incYaw)
+#define decYaw              CTRL_NAME(CTRL_PREFIX, decYaw)
+#define setYaw              CTRL_NAME(CTRL_PREFIX, setYaw)
+#define getAltSet           CTRL_NAME(CTRL_PREFIX, getAltSet)
+#define getYawSet           CTRL_NAME(CTRL_PREFIX, getYawSet)
+#define getmin_alt          CTRL_NAME(CTRL_PREFIX, getmin_alt)
+#define getmax_alt          CTRL_NAME(CTRL_PREFIX, getmax_alt)
+#define getClimbRate        CTRL_NAME(CTRL_PREFIX, getClimbRate)
+
+#endif /* CTRLRENAME_H_ */
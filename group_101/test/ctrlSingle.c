@@ -0,0 +1,15 @@
+/*
+ * ctrlSingle.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// The controller built with the single altitude PID, as single_name for altStepSim.
+
+#define ALT_CASCADE 0
+#define CTRL_PREFIX single
+#include "ctrlRename.h"
+
+#include "../pwmRotor.c"
@@ -0,0 +1,141 @@
+/*
+ * fastFmtTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// The allocation-free formatters against usprintf(). Every formatter is run over edge
+// values, zero, one either side of each power of ten, the int32_t limits, at every field
+// width up to past the widest result, and its text and returned terminator compared byte
+// for byte with what usprintf() writes for the format it replaced. Fixed point is compared
+// with the integer and fraction parts printed separately, as the display code did. Then
+// times fmtInt() and usprintf("%d") over the same values.
+//
+// usprintf() here is the C library's on the host, not ustdlib's, so the cost ratio is a
+// guide only. ustdlib parses the format the same way per call.
+
+#include <limits.h>
+#include "hostStubs.h"
+#include "utils/ustdlib.h"
+#include "../fastFmt.c"
+
+#define MAX_WIDTH (FMT_MAX_FIELD + 2)
+#define MAX_DECIMALS 4
+#define BENCH_CALLS 1000000
+
+static int32_t values[64];
+static uint8_t numValues = 0;
+
+static uint32_t compared = 0;
+
+//Edge values, the limits and either side of zero and every power of ten
+static void
+buildValues (void)
+{
+    int64_t p;
+
+    values[numValues++] = 0;
+    values[numValues++] = INT32_MAX;
+    values[numValues++] = INT32_MIN;
+    values[numValues++] = INT32_MIN + 1;
+    for (p = 1; p <= 1000000000; p *= 10) {
+        values[numValues++] = p;
+        values[numValues++] = -p;
+        values[numValues++] = p - 1 == 0 ? 5 : p - 1;
+        values[numValues++] = 1 - p == 0 ? -5 : 1 - p;
+    }
+}
+
+//Compare one result and its terminator with the reference text
+static void
+compare (const char *what, int32_t value, int width, const char *got, const char *end,
+         const char *want)
+{
+    compared++;
+    CHECK(strcmp(got, want) == 0 && end == got + strlen(want),
+          "%s(%d) width %d gave \"%s\" ending at %d, usprintf \"%s\"", what, (int) value,
+          width, got, (int) (end - got), want);
+}
+
+
+int
+main (void)
+{
+    char got[MAX_WIDTH + 8];
+    char want[MAX_WIDTH + 8];
+    char part[MAX_WIDTH + 8];
+    uint64_t start;
+    double fastNs;
+    double printfNs;
+    uint32_t sink = 0;
+    uint32_t i;
+    uint8_t v;
+    int width;
+
+    buildValues();
+
+    for (v = 0; v < numValues; v++) {
+        int32_t value = values[v];
+
+        for (width = 0; width <= MAX_WIDTH; width++) {
+            int decimals;
+
+            usprintf(want, "%*d", width, value);
+            compare("fmtInt", value, width, got, fmtInt(got, value, width), want);
+
+            usprintf(want, "%*d%%", width, value);
+            compare("fmtPercent", value, width, got, fmtPercent(got, value, width), want);
+
+            //Whole part, then the fraction zero padded, a negative fraction keeps its sign
+            for (decimals = 1; decimals <= MAX_DECIMALS; decimals++) {
+                int64_t scale = 1;
+                int64_t mag = value < 0 ? -(int64_t) value : value;
+                int d;
+
+                for (d = 0; d < decimals; d++) {
+                    scale *= 10;
+                }
+                usprintf(part, "%s%d.%0*d", value < 0 ? "-" : "", (int) (mag / scale),
+                         decimals, (int) (mag % scale));
+                usprintf(want, "%*s", width, part);
+                compare("fmtFixed", value, width, got, fmtFixed(got, value, decimals, width),
+                        want);
+            }
+        }
+    }
+
+    //Strings, and a chained line as the telemetry builds one
+    compare("fmtStr", 0, 0, got, fmtStr(got, ""), "");
+    compare("fmtStr", 0, 0, got, fmtStr(got, "Mode FLYING"), "Mode FLYING");
+    usprintf(want, "Alt(Actual/Set) %d/%d  \r\n", -12, 100);
+    {
+        char *p = fmtStr(got, "Alt(Actual/Set) ");
+        p = fmtInt(p, -12, 0);
+        p = fmtStr(p, "/");
+        p = fmtInt(p, 100, 0);
+        compare("line", 0, 0, got, fmtStr(p, "  \r\n"), want);
+    }
+    printf("fastFmt: %u results byte for byte against usprintf\n", compared);
+
+    //Relative cost over the edge values, summing a character so neither is optimised away
+    start = hostNs();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        fmtInt(got, values[i % numValues], 0);
+        sink += got[1];
+    }
+    fastNs = (double) (hostNs() - start) / BENCH_CALLS;
+    start = hostNs();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        usprintf(got, "%d", values[i % numValues]);
+        sink += got[1];
+    }
+    printfNs = (double) (hostNs() - start) / BENCH_CALLS;
+
+    printf("  fmtInt %.1f ns, usprintf(\"%%d\") %.1f ns, %.1fx (%u)\n", fastNs, printfNs,
+           printfNs / fastNs, sink & 1);
+    CHECK(fastNs < printfNs, "fmtInt %.1f ns not faster than usprintf %.1f ns", fastNs, printfNs);
+
+    return hostResult("fastFmtTest");
+}
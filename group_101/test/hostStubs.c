@@ -0,0 +1,332 @@
+/*
+ * hostStubs.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Host stand-ins for the TivaWare and OrbitOLED calls the firmware makes. Almost all do
+// nothing; the few a test can observe or steer are at the top.
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "hostStubs.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_pwm.h"
+#include "driverlib/adc.h"
+#include "driverlib/eeprom.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
+#include "driverlib/timer.h"
+#include "driverlib/uart.h"
+#include "driverlib/watchdog.h"
+#include "OrbitOLED/OrbitOLEDInterface.h"
+#include "OrbitOLED/lib_OrbitOled/OrbitOled.h"
+#include "utils/ustdlib.h"
+
+#define HOST_REGISTERS 64
+#define HOST_SYSCLOCK 20000000
+#define DWT_CYCCNT_ADDR 0xE0001004
+
+volatile uint32_t hostAdcValue[2] = { 2048, 2048 };
+volatile bool hostIntMasked = false;
+volatile bool hostSimClock = false;
+volatile uint32_t hostCycles = 0;
+volatile uint8_t hostGpioPins = 0;
+volatile uint32_t hostResetCause = 0;
+volatile uint32_t hostWatchdogFeeds = 0;
+volatile uint32_t hostPwmOutputs = 0;
+uint32_t hostEeprom[HOST_EEPROM_WORDS] = { [0 ... HOST_EEPROM_WORDS - 1] = 0xFFFFFFFF };
+void (*hostEepromProgrammed) (void) = NULL;
+hostPwmOut_t hostPwmOut[HOST_PWM_OUTPUTS];
+volatile uint32_t hostPwmSyncs = 0;
+static uint32_t numPwmOut = 0;
+
+static struct {
+    uint32_t addr;
+    uint32_t value;
+} registers[HOST_REGISTERS];
+static uint32_t numRegisters = 0;
+
+
+// *******************************************************
+// hostRegister: Storage behind HWREG. Each address gets a word the first time it is used.
+// The DWT cycle counter reads as host time in ns, or hostCycles once a simulation sets
+// hostSimClock, and the ADC0 trigger generator counts down a step per read, so busy waits on
+// either make progress.
+volatile uint32_t *
+hostRegister (uint32_t addr)
+{
+    uint32_t i;
+
+    for (i = 0; i < numRegisters && registers[i].addr != addr; i++) {
+    }
+    if (i == numRegisters) {
+        if (numRegisters == HOST_REGISTERS) {
+            fprintf(stderr, "hostRegister: out of registers at 0x%08x\n", addr);
+            i = 0;
+        } else {
+            registers[numRegisters].addr = addr;
+            registers[numRegisters].value = 0;
+            numRegisters++;
+        }
+    }
+
+    if (addr == DWT_CYCCNT_ADDR) {
+        registers[i].value = hostSimClock ? hostCycles : (uint32_t) hostNs();
+    } else if (addr == PWM0_BASE + PWM_O_0_COUNT) {
+        uint32_t period = HOST_SYSCLOCK / 1000;
+        registers[i].value = (registers[i].value + period - period / 16) % period;
+    }
+    return &registers[i].value;
+}
+
+
+uint32_t SysCtlClockGet (void) { return HOST_SYSCLOCK; }
+
+//Returns true if interrupts were already masked, as the driverlib calls do
+bool IntMasterDisable (void) { bool was = hostIntMasked; hostIntMasked = true; return was; }
+bool IntMasterEnable (void) { bool was = hostIntMasked; hostIntMasked = false; return was; }
+
+int32_t
+ADCSequenceDataGet (uint32_t base, uint32_t sequence, uint32_t *data)
+{
+    *data = hostAdcValue[base == ADC1_BASE];
+    return 1;
+}
+
+uint32_t SysCtlResetCauseGet (void) { return hostResetCause; }
+void SysCtlResetCauseClear (uint32_t causes) { hostResetCause &= ~causes; }
+void WatchdogIntClear (uint32_t base) { hostWatchdogFeeds++; }
+
+//Mock output for base and out, added the first time it is used
+static hostPwmOut_t *
+pwmOut (uint32_t base, uint32_t out)
+{
+    uint32_t i;
+
+    for (i = 0; i < numPwmOut && (hostPwmOut[i].base != base || hostPwmOut[i].out != out); i++) {
+    }
+    if (i == numPwmOut) {
+        if (numPwmOut == HOST_PWM_OUTPUTS) {
+            fprintf(stderr, "pwmOut: out of outputs at 0x%08x\n", base);
+            i = 0;
+        } else {
+            hostPwmOut[numPwmOut].base = base;
+            hostPwmOut[numPwmOut].out = out;
+            numPwmOut++;
+        }
+    }
+    return &hostPwmOut[i];
+}
+
+const hostPwmOut_t *
+hostPwmGet (uint32_t base, uint32_t out)
+{
+    return pwmOut(base, out);
+}
+
+//Output numbers carry their generator's offset, 0x40 for generator 0 up to 0x100 for 3
+void
+hostPwmBoundary (void)
+{
+    uint32_t i;
+
+    for (i = 0; i < numPwmOut; i++) {
+        uint32_t genBit = 1 << ((hostPwmOut[i].out >> 6) - 1);
+        if (HWREG(hostPwmOut[i].base + PWM_O_CTL) & genBit) {
+            hostPwmOut[i].applied = hostPwmOut[i].written;
+        }
+    }
+    for (i = 0; i < numPwmOut; i++) {
+        HWREG(hostPwmOut[i].base + PWM_O_CTL) = 0;
+    }
+}
+
+void
+PWMPulseWidthSet (uint32_t base, uint32_t out, uint32_t width)
+{
+    hostPwmOut_t *o = pwmOut(base, out);
+
+    o->written = width;
+    if (!hostIntMasked) {
+        o->unmasked++;
+    }
+}
+
+void
+PWMSyncUpdate (uint32_t base, uint32_t genBits)
+{
+    HWREG(base + PWM_O_CTL) |= genBits;
+    hostPwmSyncs++;
+}
+
+void
+PWMOutputState (uint32_t base, uint32_t outBits, bool enable)
+{
+    hostPwmOutputs = enable ? hostPwmOutputs | outBits : hostPwmOutputs & ~outBits;
+}
+
+//EEPROM addresses and counts are in bytes, a word at a time
+void
+EEPROMRead (uint32_t *data, uint32_t addr, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count / 4 && addr / 4 + i < HOST_EEPROM_WORDS; i++) {
+        data[i] = hostEeprom[addr / 4 + i];
+    }
+}
+
+uint32_t
+EEPROMProgram (uint32_t *data, uint32_t addr, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count / 4 && addr / 4 + i < HOST_EEPROM_WORDS; i++) {
+        hostEeprom[addr / 4 + i] = data[i];
+    }
+    if (hostEepromProgrammed) {
+        hostEepromProgrammed();
+    }
+    return 0;
+}
+
+uint32_t SysTickValueGet (void) { return 0; }
+uint32_t SysTickPeriodGet (void) { return HOST_SYSCLOCK / 1000; }
+uint32_t PWMGenPeriodGet (uint32_t base, uint32_t gen) { return HOST_SYSCLOCK / 300; }
+
+int
+usprintf (char *buf, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int n = vsprintf(buf, fmt, args);
+    va_end(args);
+    return n;
+}
+
+int
+usnprintf (char *buf, unsigned long size, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, size, fmt, args);
+    va_end(args);
+    return n;
+}
+
+
+// *******************************************************
+// Everything else does nothing
+
+//driverlib/adc.h
+void ADCSequenceConfigure (uint32_t p0, uint32_t p1, uint32_t p2, uint32_t p3) { }
+void ADCSequenceStepConfigure (uint32_t p0, uint32_t p1, uint32_t p2, uint32_t p3) { }
+void ADCSequenceEnable (uint32_t p0, uint32_t p1) { }
+void ADCSequenceDisable (uint32_t p0, uint32_t p1) { }
+void ADCIntRegister (uint32_t p0, uint32_t p1, void (*p2)(void)) { }
+void ADCIntEnable (uint32_t p0, uint32_t p1) { }
+void ADCIntClear (uint32_t p0, uint32_t p1) { }
+void ADCProcessorTrigger (uint32_t p0, uint32_t p1) { }
+void ADCPhaseDelaySet (uint32_t p0, uint32_t p1) { }
+void ADCHardwareOversampleConfigure (uint32_t p0, uint32_t p1) { }
+
+//driverlib/eeprom.h
+uint32_t EEPROMInit (void) { return 0; }
+
+//driverlib/gpio.h
+void GPIOIntRegister (uint32_t p0, void (*p1)(void)) { }
+void GPIOPinTypeGPIOInput (uint32_t p0, uint8_t p1) { }
+void GPIOPinTypeGPIOOutput (uint32_t p0, uint8_t p1) { }
+void GPIOPinTypePWM (uint32_t p0, uint8_t p1) { }
+void GPIOPinTypeUART (uint32_t p0, uint8_t p1) { }
+void GPIOPinTypeADC (uint32_t p0, uint8_t p1) { }
+void GPIOPinConfigure (uint32_t p0) { }
+void GPIOIntTypeSet (uint32_t p0, uint8_t p1, uint32_t p2) { }
+void GPIOIntEnable (uint32_t p0, uint32_t p1) { }
+void GPIOIntDisable (uint32_t p0, uint32_t p1) { }
+uint32_t GPIOIntStatus (uint32_t p0, bool p1) { return 0; }
+void GPIOIntClear (uint32_t p0, uint32_t p1) { }
+int32_t GPIOPinRead (uint32_t p0, uint8_t p1) { return hostGpioPins & p1; }
+void GPIOPinWrite (uint32_t p0, uint8_t p1, uint8_t p2) { }
+void GPIOPadConfigSet (uint32_t p0, uint8_t p1, uint32_t p2, uint32_t p3) { }
+void GPIODirModeSet (uint32_t p0, uint8_t p1, uint32_t p2) { }
+
+//driverlib/interrupt.h
+void IntEnable (uint32_t p0) { }
+void IntRegister (uint32_t p0, void (*p1)(void)) { }
+void IntPrioritySet (uint32_t p0, uint8_t p1) { }
+
+//driverlib/pwm.h
+void PWMGenConfigure (uint32_t p0, uint32_t p1, uint32_t p2) { }
+void PWMGenPeriodSet (uint32_t p0, uint32_t p1, uint32_t p2) { }
+void PWMGenEnable (uint32_t p0, uint32_t p1) { }
+void PWMSyncTimeBase (uint32_t p0, uint32_t p1) { }
+void PWMGenIntTrigEnable (uint32_t p0, uint32_t p1, uint32_t p2) { }
+void PWMGenIntRegister (uint32_t p0, uint32_t p1, void (*p2)(void)) { }
+void PWMGenIntClear (uint32_t p0, uint32_t p1, uint32_t p2) { }
+void PWMIntEnable (uint32_t p0, uint32_t p1) { }
+
+//driverlib/sysctl.h
+void SysCtlClockSet (uint32_t p0) { }
+void SysCtlPeripheralEnable (uint32_t p0) { }
+bool SysCtlPeripheralReady (uint32_t p0) { return 1; }
+void SysCtlPeripheralReset (uint32_t p0) { }
+void SysCtlPWMClockSet (uint32_t p0) { }
+void SysCtlDelay (uint32_t p0) { }
+void SysCtlReset (void) { }
+void SysCtlSleep (void) { }
+void SysCtlPeripheralSleepEnable (uint32_t p0) { }
+void SysCtlPeripheralClockGating (bool p0) { }
+
+//driverlib/systick.h
+void SysTickPeriodSet (uint32_t p0) { }
+void SysTickIntRegister (void (*p0)(void)) { }
+void SysTickIntEnable (void) { }
+void SysTickEnable (void) { }
+
+//driverlib/timer.h
+void TimerConfigure (uint32_t p0, uint32_t p1) { }
+void TimerLoadSet (uint32_t p0, uint32_t p1, uint32_t p2) { }
+void TimerControlTrigger (uint32_t p0, uint32_t p1, bool p2) { }
+void TimerEnable (uint32_t p0, uint32_t p1) { }
+void TimerDisable (uint32_t p0, uint32_t p1) { }
+
+//driverlib/uart.h
+void UARTConfigSetExpClk (uint32_t p0, uint32_t p1, uint32_t p2, uint32_t p3) { }
+void UARTFIFOEnable (uint32_t p0) { }
+void UARTEnable (uint32_t p0) { }
+void UARTCharPut (uint32_t p0, unsigned char p1) { }
+bool UARTSpaceAvail (uint32_t p0) { return 0; }
+bool UARTCharsAvail (uint32_t p0) { return 0; }
+int32_t UARTCharGetNonBlocking (uint32_t p0) { return 0; }
+void UARTIntRegister (uint32_t p0, void (*p1)(void)) { }
+void UARTIntEnable (uint32_t p0, uint32_t p1) { }
+uint32_t UARTIntStatus (uint32_t p0, bool p1) { return 0; }
+void UARTIntClear (uint32_t p0, uint32_t p1) { }
+void UARTCharPutNonBlocking (uint32_t p0, unsigned char p1) { }
+void UARTIntDisable (uint32_t p0, uint32_t p1) { }
+void UARTFIFOLevelSet (uint32_t p0, uint32_t p1, uint32_t p2) { }
+
+//driverlib/watchdog.h
+void WatchdogReloadSet (uint32_t p0, uint32_t p1) { }
+void WatchdogResetEnable (uint32_t p0) { }
+void WatchdogEnable (uint32_t p0) { }
+void WatchdogStallEnable (uint32_t p0) { }
+void WatchdogIntRegister (uint32_t p0, void (*p1)(void)) { }
+void WatchdogUnlock (uint32_t p0) { }
+void WatchdogLock (uint32_t p0) { }
+bool WatchdogLockState (uint32_t p0) { return 0; }
+bool WatchdogRunning (uint32_t p0) { return 0; }
+
+//OrbitOLED/OrbitOLEDInterface.h
+void OLEDInitialise (void) { }
+void OLEDStringDraw (const char *p0, unsigned long p1, unsigned long p2) { }
+
+//OrbitOLED/lib_OrbitOled/OrbitOled.h
+void OrbitOledClear (void) { }
@@ -0,0 +1,65 @@
+/*
+ * hostStubs.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include "hostTest.h"
+#include "inc/hw_types.h"
+
+#define HOST_EEPROM_WORDS 32
+#define HOST_PWM_OUTPUTS 4
+
+
+#ifndef HOSTSTUBS_H_
+#define HOSTSTUBS_H_
+
+//Next conversion result from ADC0 and ADC1
+extern volatile uint32_t hostAdcValue[2];
+
+//Set while the firmware has interrupts masked
+extern volatile bool hostIntMasked;
+
+//Set hostSimClock to run the DWT cycle counter from hostCycles rather than host time
+extern volatile bool hostSimClock;
+extern volatile uint32_t hostCycles;
+
+//Level on every GPIO pin GPIOPinRead() is asked for
+extern volatile uint8_t hostGpioPins;
+
+//Reset cause SysCtlResetCauseGet() reports until SysCtlResetCauseClear() clears it
+extern volatile uint32_t hostResetCause;
+
+//Times the watchdog has been fed, the firmware feeds it by clearing its interrupt
+extern volatile uint32_t hostWatchdogFeeds;
+
+//PWM outputs enabled by PWMOutputState(), a bit per output across both modules
+extern volatile uint32_t hostPwmOutputs;
+
+//PWM compare values as a mock of the generators. PWMPulseWidthSet() writes an output's
+//compare and PWMSyncUpdate() sets its generator's sync request bit in the module's CTL
+//register. hostPwmBoundary() is the counter zero: outputs whose generator has a sync
+//request take their written width and the request bits clear, as the hardware does before
+//the period interrupt runs.
+typedef struct {
+    uint32_t base;
+    uint32_t out;
+    uint32_t written;       //Last PWMPulseWidthSet() width, timer ticks
+    uint32_t applied;       //Width in effect this period
+    uint32_t unmasked;      //Widths written with interrupts enabled
+} hostPwmOut_t;
+
+extern hostPwmOut_t hostPwmOut[HOST_PWM_OUTPUTS];
+extern volatile uint32_t hostPwmSyncs;      //PWMSyncUpdate() calls
+
+const hostPwmOut_t *hostPwmGet (uint32_t base, uint32_t out);
+
+void hostPwmBoundary (void);
+
+//EEPROM contents, erased to all ones. hostEepromProgrammed runs after every program if set,
+//so a test can leave a handler that writes the EEPROM and then spins waiting for reset.
+extern uint32_t hostEeprom[HOST_EEPROM_WORDS];
+extern void (*hostEepromProgrammed) (void);
+
+#endif /* HOSTSTUBS_H_ */
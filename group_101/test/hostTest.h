@@ -0,0 +1,101 @@
+/*
+ * hostTest.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+#ifndef HOSTTEST_H_
+#define HOSTTEST_H_
+
+// *******************************************************
+// Shared helpers for the host tests. Each test is one program that prints what it measured
+// and exits non-zero if any CHECK failed.
+
+static int hostFailures = 0;
+
+#define CHECK(cond, ...) do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            hostFailures++; \
+        } \
+    } while (0)
+
+//Print the verdict and give the exit status
+static inline int
+hostResult (const char *name)
+{
+    printf("%s: %s\n", name, hostFailures ? "FAILED" : "passed");
+    return hostFailures ? 1 : 0;
+}
+
+//Monotonic host time in ns, for relative costs only
+static inline uint64_t
+hostNs (void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000u + t.tv_nsec;
+}
+
+// *******************************************************
+// hostReadPlant: Load the rate model v' = -a v + b u for axis, "main" or "tail", from the
+// tools/sysidFit.py parameter file given as --plant on the command line. Leaves a and b at
+// the model defaults without one. Returns false if the file cannot be read or is for the
+// other axis.
+static inline bool
+hostReadPlant (int argc, char **argv, const char *axis, double *a, double *b)
+{
+    const char *path = NULL;
+    char line[256];
+    char fileAxis[16] = "main";
+    bool haveA = false;
+    bool haveB = false;
+    FILE *f;
+    int i;
+
+    for (i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--plant") == 0) {
+            path = argv[i + 1];
+        }
+    }
+    if (path == NULL) {
+        return true;
+    }
+    if ((f = fopen(path, "r")) == NULL) {
+        printf("cannot read plant file %s\n", path);
+        return false;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        double value;
+        if (sscanf(line, " axis = %15s", fileAxis) == 1) {
+            continue;
+        }
+        if (sscanf(line, " rate_a = %lf", &value) == 1) {
+            *a = value;
+            haveA = true;
+        } else if (sscanf(line, " rate_b = %lf", &value) == 1) {
+            *b = value;
+            haveB = true;
+        }
+    }
+    fclose(f);
+    if (strcmp(fileAxis, axis) != 0 || !haveA || !haveB) {
+        printf("%s has no %s axis rate model\n", path, axis);
+        return false;
+    }
+    printf("plant from %s: a %.4g /s, b %.4g counts/s^2 per percent\n", path, *a, *b);
+    return true;
+}
+
+#endif /* HOSTTEST_H_ */
@@ -0,0 +1,150 @@
+/*
+ * medianTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Median pre-filter on the altitude samples. Checks median5() against a sort, that the
+// whole ADC path run from ADCIntHandler() keeps isolated spikes out of the mean while
+// counting them, and times the handler against its share of the sample period.
+//
+// The budget is checked from host time scaled by HOST_SLOWDOWN, a deliberately pessimistic
+// ratio between this machine and the 20 MHz Cortex-M4 with no flash wait states.
+
+#include <stdlib.h>
+#include "hostStubs.h"
+#include "../ADC.c"
+
+#define HOST_SLOWDOWN 300           //Target time over host time, pessimistic
+#define ISR_SHARE 10                //Percent of the sample period the ADC ISR may take
+#define BENCH_CALLS 2000000
+
+static uint32_t randomState = 99;
+
+static uint32_t
+nextRandom (void)
+{
+    randomState = randomState * 1103515245u + 12345u;
+    return randomState >> 8;
+}
+
+static int
+compare (const void *a, const void *b)
+{
+    return *(const uint16_t *) a - *(const uint16_t *) b;
+}
+
+static uint16_t
+sortMedian (const uint16_t *hist)
+{
+    uint16_t sorted[ALT_MEDIAN_LEN];
+    uint8_t i;
+    for (i = 0; i < ALT_MEDIAN_LEN; i++) {
+        sorted[i] = hist[i];
+    }
+    qsort(sorted, ALT_MEDIAN_LEN, sizeof(sorted[0]), compare);
+    return sorted[ALT_MEDIAN_LEN / 2];
+}
+
+//One conversion from whichever converter fires next, as the interrupts interleave them
+static void
+convert (uint16_t value)
+{
+    static bool adc1 = false;
+    hostAdcValue[adc1] = value;
+    if (adc1) {
+        ADC1IntHandler();
+    } else {
+        ADCIntHandler();
+    }
+    adc1 = ALT_DUAL_ADC && !adc1;
+}
+
+
+int
+main (void)
+{
+    uint16_t hist[ALT_MEDIAN_LEN];
+    uint32_t i;
+    uint32_t j;
+
+    //Every ordering of five values with repeats drawn from 0..3
+    for (i = 0; i < 4 * 4 * 4 * 4 * 4; i++) {
+        uint32_t v = i;
+        for (j = 0; j < ALT_MEDIAN_LEN; j++) {
+            hist[j] = v % 4;
+            v /= 4;
+        }
+        CHECK(median5(hist) == sortMedian(hist), "median5 wrong for case %u", i);
+    }
+    for (i = 0; i < 1000000; i++) {
+        for (j = 0; j < ALT_MEDIAN_LEN; j++) {
+            hist[j] = nextRandom() & 0xFFF;
+        }
+        CHECK(median5(hist) == sortMedian(hist), "median5 wrong on random window %u", i);
+        if (hostFailures > 10) {
+            break;
+        }
+    }
+
+    //Full ADC path, steady level then isolated and paired spikes either way
+    initADC();
+    for (i = 0; i < 2000; i++) {
+        convert(2000);
+    }
+    CHECK(getAltMean() == 2000, "steady 2000 reads %u", getAltMean());
+    uint32_t spikesBefore = getSpikeCount();
+    uint16_t meanMin = UINT16_MAX;
+    uint16_t meanMax = 0;
+    uint32_t spikes = 0;
+    for (i = 0; i < 4000; i++) {
+        uint16_t value = 2000;
+        if (i % 20 == 0) {
+            value = (i / 20) & 1 ? 2600 : 1400;
+            spikes++;
+        } else if (i % 20 == 10 || i % 20 == 11) {
+            value = 2900;           //Two in a row, still fewer than half the window
+            spikes++;
+        }
+        convert(value);
+        meanMin = getAltMean() < meanMin ? getAltMean() : meanMin;
+        meanMax = getAltMean() > meanMax ? getAltMean() : meanMax;
+    }
+    printf("median: %u spikes injected, %u counted, mean held at %u..%u\n", spikes,
+           getSpikeCount() - spikesBefore, meanMin, meanMax);
+    CHECK(meanMin == 2000 && meanMax == 2000, "spikes reached the mean, %u..%u", meanMin,
+          meanMax);
+    CHECK(getSpikeCount() - spikesBefore == spikes, "counted %u of %u spikes",
+          getSpikeCount() - spikesBefore, spikes);
+
+    //Cost of the median alone and of the whole handler
+    volatile uint16_t sink = 0;
+    for (j = 0; j < ALT_MEDIAN_LEN; j++) {
+        hist[j] = nextRandom() & 0xFFF;
+    }
+    uint64_t start = hostNs();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        hist[i % ALT_MEDIAN_LEN] = i & 0xFFF;
+        sink = median5(hist);
+    }
+    double medianNs = (double) (hostNs() - start) / BENCH_CALLS;
+    (void) sink;
+
+    start = hostNs();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        hostAdcValue[0] = 1990 + (i & 15);
+        ADCIntHandler();
+    }
+    double handlerNs = (double) (hostNs() - start) / BENCH_CALLS;
+
+    double budgetUs = 1e6 / ALT_SAMPLE_RATE_HZ * ISR_SHARE / 100;
+    double targetUs = handlerNs * HOST_SLOWDOWN / 1000;
+    printf("median: median5 %.1f ns, ADC handler %.1f ns on the host, ~%.1f us on target "
+           "against %.1f us (%d%% of %d Hz)\n", medianNs, handlerNs, targetUs, budgetUs,
+           ISR_SHARE, ALT_SAMPLE_RATE_HZ);
+    CHECK(targetUs < budgetUs, "ADC handler over budget, ~%.1f us", targetUs);
+
+    return hostResult("medianTest");
+}
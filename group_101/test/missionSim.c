@@ -0,0 +1,267 @@
+/*
+ * missionSim.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// The compiled in benchmark mission flown on the simulated heli, with the per segment
+// tracking error mission.c reports over telemetry. The tasks run at their main.c rates:
+// sensor tick and yaw rate loop every SysTick, the controller every CONTROL_PERIOD, and
+// missionUpdate() from the state machine at the 100 Hz button rate.
+//
+// The plants are altStepSim's altitude model, with the mixer's hover estimate below the
+// truth and the height read through a running mean, and yawLoopTest's tail model, with its
+// encoder edges through GPIOYawHandler() and the reaction torque off the coupling model.
+// Duty reaches them through the PWM generator mock, latched at each period boundary.
+// Also checks that MA refuses step and ramp altitudes under MISSION_ALT_MIN.
+
+#include <math.h>
+#include "hostStubs.h"
+#include "../mission.c"
+#include "../pwmDriver.h"
+#include "../quadrature.h"
+#include "../mixer.h"
+#include "../coupling.h"
+
+#define SIM_CLOCK 20000000          //System clock, cycles per second
+#define SIM_STEP_CYCLES 1000        //Plant step, 50 us
+#define SIM_TICK_MS (int) (DELTA_T * 1000 + 0.5)    //CONTROL_PERIOD in main.c
+#define SIM_STATE_MS 10             //BUTTON_PERIOD in main.c, the state machine pass
+#define ALT_PLANT_A 2.0             //Climb rate pole, 1/s
+#define ALT_PLANT_B 40.0            //Climb acceleration, counts/s^2 per percent
+#define SIM_LANDED 2500             //Landed ADC reading
+#define SIM_HOVER 33.0              //True hover duty, percent, the mixer starts at GRAVITY
+#define SIM_SENSOR_LAG 30           //Altitude mean length, ms
+#define SIM_YAW_A 1.5               //Yaw rate pole, 1/s
+#define SIM_YAW_B 100.0             //Yaw acceleration, counts/s^2 per percent of tail duty
+#define SIM_KC_ERROR 1.1            //Reaction torque over the coupling model's
+#define SIM_SPIN_UP 4.0             //Time to climb to MISSION_ALT_MIN before the mission, s
+#define SIM_TRACK_ALT 5.0           //Mean error allowed following a ramp or hold, %
+#define SIM_TRACK_YAW 5.0           //and degrees
+#define SIM_STEP_MARGIN_ALT 1.5     //A step's mean error over its rate limit floor, up to
+#define SIM_STEP_MARGIN_YAW 1.2     //this times the floor plus the tracking allowance
+
+#define ALT_RATE_PERCENT (100.0 * ALT_RATE_MAX / ADC_STEP_FOR_1V)   //Climb rate limit, %/s
+#define YAW_RATE_DEG (360.0 * YAW_RATE_MAX / YAW_REV)              //Yaw rate limit, deg/s
+
+//Quadrature states in clockwise order, GPIOYawHandler() counts up through them
+static const uint8_t cwStates[4] = { 0x00, 0x02, 0x03, 0x01 };
+
+//Both plants, height above landed in ADC counts and yaw in counts from the start
+typedef struct {
+    double height;
+    double climb;
+    double history[SIM_SENSOR_LAG];
+    double yaw;
+    double rate;
+    double mainLag;
+    int32_t count;
+    double mainDuty;            //Latched duty, DUTY_SCALE units
+    double tailDuty;
+    uint32_t steps;
+} plant_t;
+
+static int32_t mixedMain = 0;   //Main duty applied on the last mix, as main.c keeps it
+
+//Step both plants, raising an encoder edge for every count the yaw crosses
+static void
+plantStep (plant_t *p)
+{
+    double dt = (double) SIM_STEP_CYCLES / SIM_CLOCK;
+    double thrust = p->mainDuty / DUTY_SCALE - SIM_HOVER;
+    double torque;
+
+    p->climb += (ALT_PLANT_B * thrust - ALT_PLANT_A * p->climb) * dt;
+    p->height += p->climb * dt;
+    if (p->height < 0) {
+        p->height = 0;
+        p->climb = 0;
+    }
+
+    p->mainLag += (p->mainDuty - p->mainLag) * dt / COUPLING_TAU;
+    torque = (p->tailDuty - SIM_KC_ERROR * KC * p->mainLag) / DUTY_SCALE;
+    p->rate += (SIM_YAW_B * torque - SIM_YAW_A * p->rate) * dt;
+    p->yaw += p->rate * dt;
+    while (floor(p->yaw) != p->count) {
+        p->count += p->yaw > p->count ? 1 : -1;
+        hostGpioPins = cwStates[p->count & 3];
+        GPIOYawHandler();
+    }
+}
+
+//Altitude reading, a running mean of the height rounded to whole ADC counts
+static uint16_t
+sensor (const plant_t *p)
+{
+    double sum = 0;
+    uint8_t i;
+
+    for (i = 0; i < SIM_SENSOR_LAG; i++) {
+        sum += p->history[i];
+    }
+    return lround(SIM_LANDED - sum / SIM_SENSOR_LAG);
+}
+
+//SysTick: sensor tick and the yaw rate loop
+static void
+sysTick (void)
+{
+    int32_t remixDuty[NUM_ACTUATORS];
+    int32_t yawCut;
+
+    sensorTick();
+    yawRateUpdate();
+    if (mixerRemix(AXIS_YAW, controllerTailRate(getYawRate()), remixDuty, &yawCut)) {
+        setDuty(remixDuty[ACT_MAIN], remixDuty[ACT_TAIL]);
+        controllerTailTrack(yawCut);
+    }
+}
+
+//The controller tick in main()
+static void
+controllerTick (uint16_t alt)
+{
+    int32_t command[NUM_AXES];
+    int32_t duty[NUM_ACTUATORS];
+
+    command[AXIS_THRUST] = controllerMain(alt, getMixerOffset(ACT_MAIN));
+    command[AXIS_YAW] = controllerTail(getYawPosition());
+    command[AXIS_TORQUE] = couplingFeedForward(mixedMain, true);
+    mixerApply(command, duty);
+    mixedMain = duty[ACT_MAIN];
+    controllerMainTrack(getMixerCut(AXIS_THRUST));
+    setDuty(duty[ACT_MAIN], duty[ACT_TAIL]);
+}
+
+//Mean error over a step of size change held for ms if the setpoint were followed at the
+//rate limit and no faster, the least any controller under that limit can score
+static double
+stepFloor (double change, double rate, uint32_t ms)
+{
+    double ramp = fabs(change) / rate;
+    double seconds = ms / 1000.0;
+
+    if (ramp > seconds) {
+        return fabs(change) * (1 - seconds / ramp / 2);
+    }
+    return fabs(change) * ramp / 2 / seconds;
+}
+
+// *******************************************************
+// fly: Run every task and both plants for ms, the state machine pass calling the mission
+// as FLYING does
+static void
+fly (plant_t *p, uint32_t ms)
+{
+    const hostPwmOut_t *mainOut = hostPwmGet(PWM_MAIN_BASE, PWM_MAIN_OUTNUM);
+    const hostPwmOut_t *tailOut = hostPwmGet(PWM_TAIL_BASE, PWM_TAIL_OUTNUM);
+    uint32_t pwmPeriod = SIM_CLOCK / PWM_MAIN_FREQ;
+    uint32_t end = getSensorTick() + ms;
+
+    while (getSensorTick() != end) {
+        uint32_t step;
+
+        sysTick();
+        if (getSensorTick() % SIM_TICK_MS == 0) {
+            controllerTick(sensor(p));
+        }
+        if (getSensorTick() % SIM_STATE_MS == 0) {
+            missionStartIfArmed();
+            missionUpdate(getYawPosition(), sensor(p));
+        }
+
+        for (step = 0; step < SIM_CLOCK / 1000 / SIM_STEP_CYCLES; step++) {
+            hostCycles += SIM_STEP_CYCLES;
+            if (hostCycles % pwmPeriod < SIM_STEP_CYCLES) {
+                hostPwmBoundary();
+                PWMPeriodIntHandler();
+                p->mainDuty = (double) mainOut->applied * DUTY_PERCENT(100) / pwmPeriod;
+                p->tailDuty = (double) tailOut->applied * DUTY_PERCENT(100) / pwmPeriod;
+            }
+            plantStep(p);
+        }
+        p->history[p->steps++ % SIM_SENSOR_LAG] = p->height;
+    }
+}
+
+
+int
+main (void)
+{
+    static plant_t plant;
+    uint8_t n = sizeof(defaultMission) / sizeof(defaultMission[0]);
+    uint32_t total = 0;
+    segmentResult_t result;
+    uint8_t segment;
+    uint8_t count = 0;
+    int32_t lastAlt = MISSION_ALT_MIN;  //Setpoints each segment starts from
+    int32_t lastYaw = 0;
+
+    hostSimClock = true;
+    initialisePWM();
+    initQuad();
+    setYawZero();
+    initAltLimits(SIM_LANDED);
+    initTailLoops();
+    setYaw(0);
+
+    //Steps and ramps below the lowest mission altitude are refused, a hold's is not used
+    CHECK(!missionCommand("MA S 5 0 1000") && !missionCommand("MA R 9 0 1000"),
+          "MA accepted an altitude under %d%%", MISSION_ALT_MIN);
+    CHECK(missionCommand("MA S 10 0 1000") && missionCommand("MA H 0 0 1000"),
+          "MA refused a step at %d%% or a hold", MISSION_ALT_MIN);
+    missionClear();
+
+    //Climb to the lowest mission altitude, then fly the compiled in mission
+    setAlt(altPercentToADC(MISSION_ALT_MIN));
+    fly(&plant, SIM_SPIN_UP * 1000);
+    missionLoadDefault();
+    missionArm();
+    for (segment = 0; segment < n; segment++) {
+        total += defaultMission[segment].durationMs;
+    }
+    fly(&plant, total + 2 * SIM_STATE_MS);
+
+    printf("mission: compiled in benchmark, mean tracking error per segment\n");
+    printf("  %-3s %-5s %5s %5s %7s   %9s %9s %7s   %s\n", "seg", "type", "alt%", "yaw", "ms",
+           "alt err %", "yaw err", "samples", "step floor");
+    while (missionNextResult(&segment, &result)) {
+        const missionSegment_t *seg = &defaultMission[segment];
+        static const char *typeName[] = { "step", "ramp", "hold" };
+        double altErr = result.altErr / 10.0;
+        double yawErr = result.yawErr / 10.0;
+        double altLimit = SIM_TRACK_ALT;
+        double yawLimit = SIM_TRACK_YAW;
+
+        printf("  %-3u %-5s %5d %5d %7u   %9.1f %9.1f %7u", segment, typeName[seg->type],
+               seg->altPercent, seg->yawDeg, seg->durationMs, altErr, yawErr, result.samples);
+        if (seg->type == SEG_STEP) {
+            double altFloor = stepFloor(seg->altPercent - lastAlt, ALT_RATE_PERCENT,
+                                        seg->durationMs);
+            double yawFloor = stepFloor(angleToCentiDeg(ANGLE_FROM_DEG(seg->yawDeg - lastYaw)) /
+                                        100.0, YAW_RATE_DEG, seg->durationMs);
+            printf("   %.1f%% %.1f deg", altFloor, yawFloor);
+            altLimit += SIM_STEP_MARGIN_ALT * altFloor;
+            yawLimit += SIM_STEP_MARGIN_YAW * yawFloor;
+        }
+        printf("\n");
+        if (seg->type != SEG_HOLD) {
+            lastAlt = seg->altPercent;
+            lastYaw = seg->yawDeg;
+        }
+
+        CHECK(result.samples == seg->durationMs / SIM_STATE_MS ||
+              result.samples == seg->durationMs / SIM_STATE_MS + 1,
+              "segment %u took %u samples over %u ms", segment, result.samples, seg->durationMs);
+        CHECK(altErr <= altLimit, "segment %u altitude error %.1f%% over %.1f%%", segment,
+              altErr, altLimit);
+        CHECK(yawErr <= yawLimit, "segment %u yaw error %.1f deg over %.1f deg", segment,
+              yawErr, yawLimit);
+        count++;
+    }
+    CHECK(count == n && !missionRunning(), "%u of %u segments finished", count, n);
+
+    return hostResult("missionSim");
+}
@@ -0,0 +1,251 @@
+/*
+ * noiseSim.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Altitude noise model. Runs the firmware ADC path in both acquisition modes on the same
+// sensor signal and compares the spread of getAltMean() about the true height.
+//
+// The signal is a fixed height plus white sensor noise, 50 Hz rotor vibration, and from
+// each rotor a decaying spike at every switching edge and a supply ripple: the reading sits
+// half the ripple low while the rotor draws current and half high while it is off, moving
+// between the two at the supply's time constant. Both generators count up and
+// down at PWM_MAIN_FREQ in phase, each pulse centred on counter zero, and the duties sweep
+// slowly as they would under the controller so the edges cross every clock sample phase.
+// The clock trigger counts the same system clock, so its phase to the rotors is fixed but
+// arbitrary. The PWM synchronised build converts at counter zero and load and averages
+// ALT_PWM_OVERSAMPLE conversions, one per microsecond as at 1 Msps.
+
+#include <math.h>
+#include "hostStubs.h"
+#include "../ADC.h"
+
+void clockInitADC (void);
+void clockADCIntHandler (void);
+void clockADC1IntHandler (void);
+uint16_t clockGetAltMean (void);
+
+void pwmInitADC (void);
+void pwmADCIntHandler (void);
+uint16_t pwmGetAltMean (void);
+
+#define SIM_HEIGHT 2000.0           //True reading, ADC counts
+#define SIM_NOISE 4.0               //White noise per conversion, counts rms
+#define SIM_VIBRATION 8.0           //Rotor vibration amplitude at ALT_NOTCH_HZ, counts
+#define SIM_MAIN_EDGE 120.0         //Switching transient amplitudes, counts
+#define SIM_TAIL_EDGE 60.0
+#define SIM_EDGE_TAU 20e-6          //Transient decay, s
+#define SIM_MAIN_RIPPLE 30.0        //Supply ripple, counts peak to peak
+#define SIM_TAIL_RIPPLE 15.0
+#define SIM_RIPPLE_TAU 150e-6       //Supply time constant, s
+#define SIM_CLOCK_PHASE 0.123e-3    //ADC0 trigger offset from the rotor counter zero, s
+#define SIM_SETTLE 1.0              //Time allowed for the filters to settle, s
+#define SIM_RUN 20.0                //Time the mean is measured over, s
+#define SIM_READ (1.0 / 250)        //Controller read period, s
+
+#define PWM_PERIOD (1.0 / PWM_MAIN_FREQ)
+
+static uint32_t randomState = 12345;
+
+static double
+uniform (void)
+{
+    randomState = randomState * 1103515245u + 12345u;
+    return ((randomState >> 8) + 0.5) / (1u << 24);
+}
+
+//Box-Muller, one normal deviate per call
+static double
+gaussian (void)
+{
+    return sqrt(-2 * log(uniform())) * cos(2 * M_PI * uniform());
+}
+
+//Duties as fractions, swept slowly as the controller would
+static double
+mainDuty (double t)
+{
+    return 0.40 + 0.08 * sin(2 * M_PI * 0.7 * t);
+}
+
+static double
+tailDuty (double t)
+{
+    return 0.30 + 0.10 * sin(2 * M_PI * 1.3 * t);
+}
+
+//Decaying step left at time t by the edges of a pulse of the given duty centred on counter
+//zero, rising edges positive
+static double
+edgeDecay (double t, double duty, double tau)
+{
+    long k = lround(t / PWM_PERIOD);
+    double sum = 0;
+    long i;
+
+    for (i = k - 1; i <= k + 1; i++) {
+        double rise = t - (i * PWM_PERIOD - duty * PWM_PERIOD / 2);
+        double fall = t - (i * PWM_PERIOD + duty * PWM_PERIOD / 2);
+        if (rise >= 0 && rise < 10 * tau) {
+            sum += exp(-rise / tau);
+        }
+        if (fall >= 0 && fall < 10 * tau) {
+            sum -= exp(-fall / tau);
+        }
+    }
+    return sum;
+}
+
+//Switching noise from one rotor, edge spikes and the supply ripple
+static double
+rotorNoise (double t, double duty, double edge, double ripple)
+{
+    double fromZero = fabs(t - lround(t / PWM_PERIOD) * PWM_PERIOD);
+    double on = (fromZero < duty * PWM_PERIOD / 2) - edgeDecay(t, duty, SIM_RIPPLE_TAU);
+
+    return edge * edgeDecay(t, duty, SIM_EDGE_TAU) + ripple * (0.5 - on);
+}
+
+//One conversion at time t
+static uint32_t
+conversion (double t, bool rotors)
+{
+    double v = SIM_HEIGHT + SIM_NOISE * gaussian() + SIM_VIBRATION * sin(2 * M_PI * ALT_NOTCH_HZ * t);
+
+    if (rotors) {
+        v += rotorNoise(t, mainDuty(t), SIM_MAIN_EDGE, SIM_MAIN_RIPPLE);
+        v += rotorNoise(t, tailDuty(t), SIM_TAIL_EDGE, SIM_TAIL_RIPPLE);
+    }
+    if (v < 0) {
+        v = 0;
+    } else if (v > 4095) {
+        v = 4095;
+    }
+    return lround(v);
+}
+
+//Spread of the controller's reads of the mean about the true height
+typedef struct {
+    double sum;
+    double sumSq;
+    uint32_t n;
+} spread_t;
+
+static void
+record (spread_t *s, uint16_t mean)
+{
+    double e = mean - SIM_HEIGHT;
+    s->sum += e;
+    s->sumSq += e * e;
+    s->n++;
+}
+
+static double
+bias (const spread_t *s)
+{
+    return s->sum / s->n;
+}
+
+static double
+deviation (const spread_t *s)
+{
+    double m = bias(s);
+    return sqrt(s->sumSq / s->n - m * m);
+}
+
+// *******************************************************
+// Clock triggered: ADC0 every 1/SAMPLE_RATE_HZ, ADC1 half way between, one conversion each.
+// Runs from start, measures without the rotors then with them, each after a settle.
+static void
+runClock (spread_t *quiet, spread_t *noisy)
+{
+    double period = 1.0 / ALT_SAMPLE_RATE_HZ;   //ADC.h here is the clock triggered default
+    double nextRead = 0;
+    double t;
+    uint32_t k;
+
+    clockInitADC();
+    for (k = 0; (t = SIM_CLOCK_PHASE + k * period) < 2 * (SIM_SETTLE + SIM_RUN); k++) {
+        bool rotors = t >= SIM_SETTLE + SIM_RUN;
+        double phase = t - (rotors ? SIM_SETTLE + SIM_RUN : 0);
+
+        hostAdcValue[k & 1] = conversion(t, rotors);
+        if (k & 1) {
+            clockADC1IntHandler();
+        } else {
+            clockADCIntHandler();
+        }
+        for (; nextRead <= t; nextRead += SIM_READ) {
+            if (phase >= SIM_SETTLE) {
+                record(rotors ? noisy : quiet, clockGetAltMean());
+            }
+        }
+    }
+}
+
+// *******************************************************
+// PWM synchronised: ADC0 at the main generator's counter zero and load, averaging
+// ALT_PWM_OVERSAMPLE conversions a microsecond apart.
+static void
+runPwm (spread_t *quiet, spread_t *noisy)
+{
+    double nextRead = 0;
+    double t;
+    uint32_t k;
+
+    pwmInitADC();
+    for (k = 0; (t = k * PWM_PERIOD / 2) < 2 * (SIM_SETTLE + SIM_RUN); k++) {
+        bool rotors = t >= SIM_SETTLE + SIM_RUN;
+        double phase = t - (rotors ? SIM_SETTLE + SIM_RUN : 0);
+        uint32_t sum = 0;
+        uint8_t i;
+
+        for (i = 0; i < ALT_PWM_OVERSAMPLE; i++) {
+            sum += conversion(t + i * 1e-6, rotors);
+        }
+        hostAdcValue[0] = (sum + ALT_PWM_OVERSAMPLE / 2) / ALT_PWM_OVERSAMPLE;
+        pwmADCIntHandler();
+        for (; nextRead <= t; nextRead += SIM_READ) {
+            if (phase >= SIM_SETTLE) {
+                record(rotors ? noisy : quiet, pwmGetAltMean());
+            }
+        }
+    }
+}
+
+
+int
+main (void)
+{
+    spread_t clockQuiet = { 0 }, clockNoisy = { 0 };
+    spread_t pwmQuiet = { 0 }, pwmNoisy = { 0 };
+
+    runClock(&clockQuiet, &clockNoisy);
+    randomState = 12345;
+    runPwm(&pwmQuiet, &pwmNoisy);
+
+    printf("noise model, getAltMean() about the true height over %.0f s, counts\n", SIM_RUN);
+    printf("  %-18s %10s %10s %10s %10s %10s\n", "", "sd quiet", "bias quiet",
+           "sd rotors", "bias rotors", "var ratio");
+    printf("  %-18s %10.3f %10.3f %10.3f %10.3f %10s\n", "clock triggered",
+           deviation(&clockQuiet), bias(&clockQuiet), deviation(&clockNoisy), bias(&clockNoisy), "1");
+    printf("  %-18s %10.3f %10.3f %10.3f %10.3f %10.3f\n", "PWM synchronised",
+           deviation(&pwmQuiet), bias(&pwmQuiet), deviation(&pwmNoisy), bias(&pwmNoisy),
+           pow(deviation(&pwmNoisy) / deviation(&clockNoisy), 2));
+
+    //Sampling clear of the edges has to take out most of the switching noise and leave
+    //close to the quiet floor. The ripple has not settled by the middle of the tail's
+    //narrowest pulse, which leaves up to a count of offset.
+    CHECK(deviation(&pwmNoisy) < deviation(&clockNoisy) / 2,
+          "PWM synchronised sd %.3f not under half the clock's %.3f",
+          deviation(&pwmNoisy), deviation(&clockNoisy));
+    CHECK(fabs(bias(&pwmNoisy)) < 1, "PWM synchronised mean off by %.3f", bias(&pwmNoisy));
+    CHECK(deviation(&pwmNoisy) < 1.5 * deviation(&pwmQuiet) + 0.1,
+          "PWM synchronised sd %.3f with the rotors against %.3f without",
+          deviation(&pwmNoisy), deviation(&pwmQuiet));
+
+    return hostResult("noiseSim");
+}
@@ -0,0 +1,181 @@
+/*
+ * pidTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Anti-windup and mode transfer in the shared PID engine. Step tests on the climb rate
+// loop measure recovery from saturation with back-calculation against the same loop with
+// kt = 0, once for the loop's own output limit and once for a cut made after it and
+// reported through pidTrack(). Then checks that pidSetGains() and pidReset() do not bump
+// the output.
+//
+// The plant is the altitude model, climb rate v' = -ALT_PLANT_A v + ALT_PLANT_B u with u
+// the thrust in percent about hover, on the ground at zero height.
+
+#include <math.h>
+#include "hostTest.h"
+#include "../pid.c"
+#include "../mixer.h"
+
+#define ALT_PLANT_A 2.0             //Climb rate pole, 1/s
+#define ALT_PLANT_B 40.0            //Climb acceleration, counts/s^2 per percent
+#define SIM_DT 0.001                //Plant step, s
+#define SIM_TICKS (int) (DELTA_T / SIM_DT + 0.5)
+#define SIM_HOLD 3.0                //Time held in saturation, s
+#define SIM_RECOVER 5.0             //Time allowed to recover, s
+#define SIM_SETTLE_BAND 0.05        //Recovered within this fraction of the new setpoint
+#define SIM_CAP 5.0                 //Thrust cap downstream of the loop, percent
+
+#define THRUST_MIN (PWM_DUTY_MAIN_MIN - GRAVITY)
+#define THRUST_MAX (PWM_DUTY_MAIN_MAX - GRAVITY)
+
+//Climb rate plant on the ground
+typedef struct {
+    double height;
+    double rate;
+} plant_t;
+
+static void
+plantStep (plant_t *p, double thrust)
+{
+    p->rate += (-ALT_PLANT_A * p->rate + ALT_PLANT_B * thrust) * SIM_DT;
+    p->height += p->rate * SIM_DT;
+    if (p->height <= 0) {
+        p->height = 0;
+        if (p->rate < 0) {
+            p->rate = 0;
+        }
+    }
+}
+
+// *******************************************************
+// fly: Run the rate loop towards rateSet for seconds, the applied thrust capped at cap
+// after the loop as the health limit and mixer do. Returns the time the rate last sat
+// outside SIM_SETTLE_BAND of rateSet, and the worst overshoot past it in overshoot.
+static double
+fly (pidCtrl_t *pid, plant_t *p, double rateSet, double seconds, double cap, double *overshoot)
+{
+    double thrust = 0;
+    double settle = 0;
+    uint32_t ms;
+
+    *overshoot = 0;
+    for (ms = 0; ms < seconds * 1000; ms++) {
+        if (ms % SIM_TICKS == 0) {
+            double out = pidUpdate(pid, rateSet, p->rate, DELTA_T);
+            thrust = out > cap ? cap : out;
+            pidTrack(pid, thrust - out, DELTA_T);
+        }
+        plantStep(p, thrust);
+
+        if (p->rate - rateSet > *overshoot) {
+            *overshoot = p->rate - rateSet;
+        }
+        if (fabs(p->rate - rateSet) > SIM_SETTLE_BAND * fabs(rateSet)) {
+            settle = (ms + 1) / 1000.0;
+        }
+    }
+    return settle;
+}
+
+//Fresh climb rate loop, with back-calculation or without
+static void
+rateLoop (pidCtrl_t *pid, bool backCalc)
+{
+    pidInit(pid, KPV, KIV, KDV, THRUST_MIN, THRUST_MAX);
+    if (!backCalc) {
+        pid->kt = 0;
+    }
+}
+
+// *******************************************************
+// Held on the ground commanding a descent, the loop sits on its lower limit, then asked to
+// climb at the rate limit. Returns the recovery time.
+static double
+groundHold (bool backCalc)
+{
+    pidCtrl_t pid;
+    plant_t p = { 0 };
+    double overshoot;
+    double settle;
+
+    rateLoop(&pid, backCalc);
+    fly(&pid, &p, -ALT_RATE_MAX / 2, SIM_HOLD, THRUST_MAX, &overshoot);
+    printf("  output limit   %-17s integral %7.1f%%  ", backCalc ? "back-calculation" : "kt = 0",
+           pid.integral);
+    settle = fly(&pid, &p, ALT_RATE_MAX, SIM_RECOVER, THRUST_MAX, &overshoot);
+    printf("recover %.2f s overshoot %.0f counts/s\n", settle, overshoot);
+    return settle;
+}
+
+// *******************************************************
+// Climbing with the thrust capped downstream at SIM_CAP, then the cap lifted. Returns the
+// recovery time and the overshoot.
+static double
+cappedClimb (bool backCalc, double *overshoot)
+{
+    pidCtrl_t pid;
+    plant_t p = { 0 };
+    double settle;
+
+    rateLoop(&pid, backCalc);
+    fly(&pid, &p, ALT_RATE_MAX, SIM_HOLD, SIM_CAP, overshoot);
+    printf("  downstream cut %-17s integral %7.1f%%  ", backCalc ? "back-calculation" : "kt = 0",
+           pid.integral);
+    settle = fly(&pid, &p, ALT_RATE_MAX, SIM_RECOVER, THRUST_MAX, overshoot);
+    printf("recover %.2f s overshoot %.0f counts/s\n", settle, *overshoot);
+    return settle;
+}
+
+
+int
+main (void)
+{
+    pidCtrl_t pid;
+    plant_t p = { 0 };
+    double withBack;
+    double without;
+    double overBack;
+    double overWithout;
+    float before;
+    float after;
+
+    printf("pid: climb rate step after %.0f s in saturation\n", SIM_HOLD);
+    withBack = groundHold(true);
+    without = groundHold(false);
+    CHECK(withBack < without / 2, "back-calculation recovered in %.2f s against %.2f s",
+          withBack, without);
+
+    withBack = cappedClimb(true, &overBack);
+    without = cappedClimb(false, &overWithout);
+    CHECK(withBack < without / 2, "back-calculation recovered from the cap in %.2f s against %.2f s",
+          withBack, without);
+    CHECK(overBack < overWithout / 2, "back-calculation overshot %.0f against %.0f counts/s",
+          overBack, overWithout);
+
+    //Gain switch mid flight, the output carries on but for the last step's integral
+    pidInit(&pid, KPV, KIV, KDV, THRUST_MIN, THRUST_MAX);
+    pidUpdate(&pid, 100, 20, DELTA_T);
+    before = pidUpdate(&pid, 100, 40, DELTA_T);
+    pidSetGains(&pid, KPV * ALT_TAKEOFF_KP_SCALE, KIV * ALT_TAKEOFF_KI_SCALE, KDV);
+    after = pidUpdate(&pid, 100, 40, DELTA_T);
+    printf("pid: gain switch %.4f before, %.4f after\n", before, after);
+    CHECK(fabsf(after - before - KIV * 60 * DELTA_T) < 1e-4,
+          "gain switch bumped the output from %.4f to %.4f", before, after);
+    CHECK(fabsf(pid.kt - ALT_TAKEOFF_KI_SCALE / ALT_TAKEOFF_KP_SCALE * KIV / KPV) < 1e-4,
+          "tracking gain %.4f not ki / kp after the switch", pid.kt);
+
+    //Reset clears the integral and seeds the derivative, so the first output is kp * error
+    pidInit(&pid, KPV, KIV, 0.01, THRUST_MIN, THRUST_MAX);
+    fly(&pid, &p, ALT_RATE_MAX, SIM_HOLD, SIM_CAP, &overBack);
+    pidReset(&pid, 50);
+    after = pidUpdate(&pid, 0, 50, DELTA_T);
+    printf("pid: first output after reset %.4f\n", after);
+    CHECK(fabsf(after - KPV * -50) < 1e-4, "first output after reset %.4f, not %.4f",
+          after, KPV * -50);
+
+    return hostResult("pidTest");
+}
@@ -0,0 +1,187 @@
+/*
+ * pwmTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// PWM driver against the generator mock in hostStubs.c. Checks that a duty pair written by
+// setDuty() is held until the next counter zero and then applied to both rotors in the same
+// period, including a request that lands between the latch and the period interrupt. Then
+// makes random requests over many periods, records the pair applied each period, and
+// checks it and PWMPeriodIntHandler()'s update, overwrite and latency counts against what
+// the requests should have given. Last that setDuty() writes with interrupts masked and
+// hands back the caller's mask.
+//
+// Time is the simulated cycle counter, each period boundary falls every main PWM period.
+
+#include "hostStubs.h"
+#include "../pwmDriver.c"
+
+#define SIM_PERIODS 2000            //Periods of random requests
+#define SIM_MAX_REQUESTS 3          //Requests per period, up to
+
+static uint32_t randomState = 12345;
+
+static uint32_t
+random32 (void)
+{
+    randomState = randomState * 1103515245u + 12345u;
+    return randomState >> 8;
+}
+
+//Timer ticks setDuty() gives a duty on a generator of this period
+static uint32_t
+width (uint32_t period, uint32_t duty)
+{
+    return period * duty / DUTY_PERCENT(100);
+}
+
+//Counter zero, the generators latch then the period interrupt runs
+static void
+boundary (uint32_t *periodStart)
+{
+    *periodStart += periodMain;
+    hostCycles = *periodStart;
+    hostPwmBoundary();
+    PWMPeriodIntHandler();
+}
+
+
+int
+main (void)
+{
+    const hostPwmOut_t *mainOut = hostPwmGet(PWM_MAIN_BASE, PWM_MAIN_OUTNUM);
+    const hostPwmOut_t *tailOut = hostPwmGet(PWM_TAIL_BASE, PWM_TAIL_OUTNUM);
+    uint32_t periodStart = 0;
+    uint32_t mainWrites;
+    uint32_t tailWrites;
+    uint32_t mismatched = 0;
+    uint32_t expectUpdates = 0;
+    uint32_t expectOverwrites = 0;
+    uint32_t expectMin = UINT32_MAX;
+    uint32_t expectMax = 0;
+    uint32_t lastMain = 0;
+    uint32_t lastTail = 0;
+    uint32_t syncs;
+    pwmStats_t before;
+    pwmStats_t stats;
+    uint32_t k;
+
+    hostSimClock = true;
+    hostCycles = 0;
+    initialisePWM();
+    mainWrites = mainOut->unmasked;
+    tailWrites = tailOut->unmasked;
+    boundary(&periodStart);
+    CHECK(mainOut->applied == 0 && tailOut->applied == 0, "rotors start at %u and %u ticks",
+          mainOut->applied, tailOut->applied);
+    getPwmStats(&stats);
+
+    //A pair is held until the boundary and then both widths apply in the same period
+    hostCycles = periodStart + periodMain / 3;
+    setDuty(DUTY_PERCENT(40), DUTY_PERCENT(25));
+    CHECK(mainOut->written == width(periodMain, DUTY_PERCENT(40)) &&
+          tailOut->written == width(periodTail, DUTY_PERCENT(25)), "widths not written");
+    CHECK(mainOut->applied == 0 && tailOut->applied == 0,
+          "widths applied before the boundary, %u and %u", mainOut->applied, tailOut->applied);
+    boundary(&periodStart);
+    CHECK(mainOut->applied == width(periodMain, DUTY_PERCENT(40)) &&
+          tailOut->applied == width(periodTail, DUTY_PERCENT(25)),
+          "boundary applied %u and %u ticks", mainOut->applied, tailOut->applied);
+    getPwmStats(&stats);
+    CHECK(stats.updates == 1 && stats.appliedMain == DUTY_PERCENT(40) &&
+          stats.appliedTail == DUTY_PERCENT(25), "update not recorded");
+    CHECK(stats.latencyUs == (periodMain - periodMain / 3) / cyclesPerUs,
+          "latency %u us, not %u", stats.latencyUs, (periodMain - periodMain / 3) / cyclesPerUs);
+
+    //A request between the latch and the interrupt waits for the next period
+    periodStart += periodMain;
+    hostCycles = periodStart;
+    hostPwmBoundary();
+    setDuty(DUTY_PERCENT(50), DUTY_PERCENT(30));
+    PWMPeriodIntHandler();
+    getPwmStats(&stats);
+    CHECK(stats.updates == 1 && stats.appliedMain == DUTY_PERCENT(40),
+          "request after the latch counted as applied");
+    CHECK(mainOut->applied == width(periodMain, DUTY_PERCENT(40)),
+          "request after the latch applied early");
+    boundary(&periodStart);
+    getPwmStats(&stats);
+    CHECK(stats.updates == 2 && stats.appliedMain == DUTY_PERCENT(50) &&
+          stats.appliedTail == DUTY_PERCENT(30), "late request not applied next period");
+    lastMain = DUTY_PERCENT(50);
+    lastTail = DUTY_PERCENT(30);
+    before = stats;
+    syncs = hostPwmSyncs;
+
+    //Random requests at random points in each period, the last one before a boundary is
+    //the pair applied through the next period
+    for (k = 0; k < SIM_PERIODS; k++) {
+        uint32_t requests = random32() % (SIM_MAX_REQUESTS + 1);
+        uint32_t offset = 0;
+        uint32_t r;
+
+        for (r = 0; r < requests; r++) {
+            offset += random32() % ((periodMain - offset) / 2);
+            hostCycles = periodStart + offset;
+            lastMain = random32() % DUTY_PERCENT(100);
+            lastTail = random32() % DUTY_PERCENT(100);
+            setDuty(lastMain, lastTail);
+        }
+        if (requests > 0) {
+            uint32_t latency = (periodMain - offset) / cyclesPerUs;
+            expectUpdates++;
+            expectOverwrites += requests - 1;
+            expectMin = latency < expectMin ? latency : expectMin;
+            expectMax = latency > expectMax ? latency : expectMax;
+        }
+        boundary(&periodStart);
+
+        if (mainOut->applied != width(periodMain, lastMain) ||
+            tailOut->applied != width(periodTail, lastTail)) {
+            mismatched++;
+        }
+    }
+    getPwmStats(&stats);
+    stats.periods -= before.periods;
+    stats.updates -= before.updates;
+    stats.overwrites -= before.overwrites;
+    printf("pwm: %u periods, %u updates, %u overwrites\n", stats.periods, stats.updates,
+           stats.overwrites);
+    printf("  latency %u to %u us, jitter %u us\n", stats.latencyMinUs, stats.latencyMaxUs,
+           stats.latencyMaxUs - stats.latencyMinUs);
+    CHECK(mismatched == 0, "%u periods applied a pair other than the last request", mismatched);
+    CHECK(stats.periods == SIM_PERIODS, "%u periods counted, not %u", stats.periods, SIM_PERIODS);
+    CHECK(stats.updates == expectUpdates, "%u updates, not %u", stats.updates, expectUpdates);
+    CHECK(stats.overwrites == expectOverwrites, "%u overwrites, not %u", stats.overwrites,
+          expectOverwrites);
+    CHECK(hostPwmSyncs - syncs == 2 * (expectUpdates + expectOverwrites),
+          "%u sync requests for %u duty pairs", hostPwmSyncs - syncs,
+          expectUpdates + expectOverwrites);
+    CHECK(stats.latencyMinUs == expectMin && stats.latencyMaxUs == expectMax,
+          "latency %u to %u us, not %u to %u", stats.latencyMinUs, stats.latencyMaxUs,
+          expectMin, expectMax);
+    CHECK(stats.appliedMain == lastMain && stats.appliedTail == lastTail,
+          "stats applied %u and %u, not %u and %u", stats.appliedMain, stats.appliedTail,
+          lastMain, lastTail);
+
+    //Reading the stats starts a new latency window
+    getPwmStats(&stats);
+    CHECK(stats.latencyMinUs == UINT32_MAX && stats.latencyMaxUs == 0,
+          "latency window not restarted, %u to %u us", stats.latencyMinUs, stats.latencyMaxUs);
+
+    //Both widths are written masked, and the caller's mask is handed back either way
+    CHECK(mainOut->unmasked == mainWrites && tailOut->unmasked == tailWrites,
+          "setDuty() wrote %u widths with interrupts enabled",
+          mainOut->unmasked - mainWrites + tailOut->unmasked - tailWrites);
+    hostIntMasked = true;
+    setDuty(DUTY_PERCENT(40), DUTY_PERCENT(25));
+    CHECK(hostIntMasked, "setDuty() unmasked interrupts it was called with masked");
+    hostIntMasked = false;
+    setDuty(DUTY_PERCENT(40), DUTY_PERCENT(25));
+    CHECK(!hostIntMasked, "setDuty() left interrupts masked");
+
+    return hostResult("pwmTest");
+}
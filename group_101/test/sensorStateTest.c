@@ -0,0 +1,152 @@
+/*
+ * sensorStateTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Seqlock stress test. readSensorSnapshot() calls SENSOR_READ_HOOK() between each of its
+// accesses to the shared state; here the hook plays the ADC, yaw and SysTick ISRs,
+// publishing at those boundaries on a schedule. Every schedule over the first passes of the
+// reader is run, then a long random run. The reader must always come back with the state
+// as it stood after the last complete publish, never a mix of two.
+
+#include "hostTest.h"
+
+static void hostReadHook (void);
+#define SENSOR_READ_HOOK() hostReadHook()
+
+#include "../sensorState.c"
+
+#define HOOKS_PER_PASS 4
+#define SCHEDULE_HOOKS 12   //Three reader passes, every subset of these boundaries is run
+
+//What the ISRs have published, the state a reader must see
+static uint32_t expectTimestamp;
+static angle_t expectYaw;
+static uint16_t expectAlt;
+
+//Injection schedule, bit n set publishes at the nth hook call
+static uint32_t schedule;
+static uint32_t hookCalls;
+static uint32_t injections;
+static uint32_t value = 1;
+static uint32_t randomState = 12345;
+
+
+//One ISR's worth of publishing, kind chosen so alt, yaw and tick changes all get injected
+static void
+injectPublish (uint32_t kind)
+{
+    value++;
+    switch (kind % 4) {
+    case 0:
+        publishAlt(value & 0xFFF);
+        expectAlt = value & 0xFFF;
+        break;
+    case 1:
+        publishYaw(value * 7);
+        expectYaw = value * 7;
+        break;
+    case 2:
+        sensorTick();
+        publishAlt(value & 0xFFF);
+        expectAlt = value & 0xFFF;
+        break;
+    default:
+        //Yaw ISR straight after the ADC ISR, back to back before the reader resumes
+        publishAlt(value & 0xFFF);
+        publishYaw(value * 7);
+        expectAlt = value & 0xFFF;
+        expectYaw = value * 7;
+        break;
+    }
+    expectTimestamp = getSensorTick();
+}
+
+
+static void
+hostReadHook (void)
+{
+    if (hookCalls < 32 && (schedule & (1u << hookCalls))) {
+        injectPublish(injections + hookCalls);
+        injections++;
+    }
+    hookCalls++;
+}
+
+
+static uint32_t
+nextRandom (void)
+{
+    randomState = randomState * 1103515245u + 12345u;
+    return randomState >> 8;
+}
+
+
+//Run one read under the current schedule and check it saw the latest complete state
+static void
+readAndCheck (void)
+{
+    sensorState_t snapshot;
+
+    hookCalls = 0;
+    injections = 0;
+    readSensorSnapshot(&snapshot);
+
+    CHECK(snapshot.alt == expectAlt && snapshot.yaw == expectYaw &&
+          snapshot.timestamp == expectTimestamp,
+          "schedule 0x%03x: got alt %u yaw %u ts %u, published alt %u yaw %u ts %u",
+          schedule, snapshot.alt, snapshot.yaw, snapshot.timestamp,
+          expectAlt, expectYaw, expectTimestamp);
+    CHECK(!(snapshot.seq & 1), "schedule 0x%03x: odd sequence %u", schedule, snapshot.seq);
+
+    //A publish on a pass forces another, so the reader stops at the first quiet pass
+    uint32_t passes = 1;
+    while (schedule & (((1u << HOOKS_PER_PASS) - 1) << ((passes - 1) * HOOKS_PER_PASS))) {
+        passes++;
+    }
+    CHECK(hookCalls == passes * HOOKS_PER_PASS,
+          "schedule 0x%03x: %u hook calls, expected %u", schedule, hookCalls,
+          passes * HOOKS_PER_PASS);
+}
+
+
+int
+main (void)
+{
+    uint32_t i;
+    uint32_t reads = 0;
+
+    injectPublish(3);
+
+    //Every subset of the boundaries over the first three passes
+    for (schedule = 0; schedule < (1u << SCHEDULE_HOOKS); schedule++) {
+        readAndCheck();
+        reads++;
+    }
+
+    //Long random run, publishing at a quarter of the boundaries over up to eight passes
+    for (i = 0; i < 200000; i++) {
+        uint32_t j;
+        schedule = 0;
+        for (j = 0; j < 8 * HOOKS_PER_PASS; j++) {
+            if ((nextRandom() & 3) == 0) {
+                schedule |= 1u << j;
+            }
+        }
+        hookCalls = 0;
+        injections = 0;
+
+        sensorState_t snapshot;
+        readSensorSnapshot(&snapshot);
+        CHECK(snapshot.alt == expectAlt && snapshot.yaw == expectYaw &&
+              snapshot.timestamp == expectTimestamp,
+              "random schedule 0x%08x: torn snapshot", schedule);
+        reads++;
+    }
+
+    printf("sensorState: %u reads with publishes injected at every reader boundary\n", reads);
+    return hostResult("sensorStateTest");
+}
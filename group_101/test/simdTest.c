@@ -0,0 +1,194 @@
+/*
+ * simdTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Dual 16 bit kernels against the plain scalar code they replace. The packed biquad must
+// give bit for bit the output of a scalar direct form I with the same Q14 coefficients,
+// and the packed sample buffer must hold what a word per sample buffer holds in half the
+// RAM. Both are timed against the scalar versions, including the old getAltMean() loop
+// that summed the buffer one entry at a time on every read.
+//
+// Host timings use the portable SIMD_MAC2 fallback, so they show the packing overhead only;
+// on target SIMD_MAC2 is one SMLAD against two MLAs.
+
+#include <stdlib.h>
+#include "hostTest.h"
+#include "../biquad.h"
+#include "../circBufT.h"
+#include "../ADC.h"
+
+#define SAMPLES 2000000
+
+static uint32_t randomState = 7;
+
+static uint32_t
+nextRandom (void)
+{
+    randomState = randomState * 1103515245u + 12345u;
+    return randomState >> 8;
+}
+
+//Scalar direct form I with separate coefficients, the reference for the packed sections
+typedef struct {
+    int32_t b0, b1, b2, a1, a2;     //a1 and a2 negated as in biquad_t
+    int16_t x1, x2, y1, y2;
+    int32_t residue;
+} scalarSection_t;
+
+static void
+unpack (const biquad_t *q, scalarSection_t *s)
+{
+    s->b0 = (int16_t) q->b0b1;
+    s->b1 = (int16_t) (q->b0b1 >> 16);
+    s->b2 = (int16_t) q->b2a1;
+    s->a1 = (int16_t) (q->b2a1 >> 16);
+    s->a2 = q->a2;
+    s->x1 = q->x1;
+    s->x2 = q->x2;
+    s->y1 = q->y1;
+    s->y2 = q->y2;
+    s->residue = q->residue;
+}
+
+static int16_t
+scalarCascade (scalarSection_t *sections, uint8_t count, int16_t sample)
+{
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        scalarSection_t *s = &sections[i];
+        int32_t acc = s->residue + s->b0 * sample + s->b1 * s->x1 + s->b2 * s->x2 +
+                      s->a1 * s->y1 + s->a2 * s->y2;
+        s->residue = acc & ((1 << BIQUAD_Q) - 1);
+        acc >>= BIQUAD_Q;
+        if (acc > INT16_MAX) {
+            acc = INT16_MAX;
+        } else if (acc < INT16_MIN) {
+            acc = INT16_MIN;
+        }
+        s->x2 = s->x1;
+        s->x1 = sample;
+        s->y2 = s->y1;
+        s->y1 = acc;
+        sample = acc;
+    }
+    return sample;
+}
+
+
+int
+main (void)
+{
+    biquad_t packed[ALT_BIQUAD_SECTIONS];
+    scalarSection_t scalar[ALT_BIQUAD_SECTIONS];
+    uint32_t i;
+
+    //Dual MAC against two scalar multiplies, extremes included
+    static const int16_t edge[] = { INT16_MIN, -1, 0, 1, INT16_MAX };
+    for (i = 0; i < 1000000; i++) {
+        int16_t a = i < 625 ? edge[i % 5] : nextRandom();
+        int16_t b = i < 625 ? edge[i / 5 % 5] : nextRandom();
+        int16_t c = i < 625 ? edge[i / 25 % 5] : nextRandom();
+        int16_t d = i < 625 ? edge[i / 125 % 5] : nextRandom();
+        int32_t acc = (int32_t) (nextRandom() & 0xFFFF) - 0x8000;
+        int64_t expect = (int64_t) acc + a * c + b * d;
+        if (expect < INT32_MIN || expect > INT32_MAX) {
+            continue;       //SMLAD wraps, the filters never get near it
+        }
+        CHECK(SIMD_MAC2(SIMD_PACK2(a, b), SIMD_PACK2(c, d), acc) == expect,
+              "SIMD_MAC2 %d %d %d %d", a, b, c, d);
+        if (hostFailures > 10) {
+            break;
+        }
+    }
+
+    //Packed biquads bit exact against the scalar form on noisy altitude samples
+    biquadNotch(&packed[0], ALT_NOTCH_HZ, ALT_NOTCH_Q, ALT_SAMPLE_RATE_HZ);
+    biquadLowPass(&packed[1], ALT_LOWPASS_HZ, ALT_LOWPASS_Q, ALT_SAMPLE_RATE_HZ);
+    for (i = 0; i < ALT_BIQUAD_SECTIONS; i++) {
+        biquadReset(&packed[i], 2048 << ALT_FILTER_SHIFT);
+        unpack(&packed[i], &scalar[i]);
+    }
+    for (i = 0; i < SAMPLES; i++) {
+        int16_t x = ((1500 + (nextRandom() & 1023)) << ALT_FILTER_SHIFT);
+        int16_t yp = biquadCascade(packed, ALT_BIQUAD_SECTIONS, x);
+        int16_t ys = scalarCascade(scalar, ALT_BIQUAD_SECTIONS, x);
+        if (yp != ys) {
+            CHECK(false, "packed %d, scalar %d at sample %u", yp, ys, i);
+            break;
+        }
+    }
+
+    volatile int16_t sink = 0;
+    uint64_t start = hostNs();
+    for (i = 0; i < SAMPLES; i++) {
+        sink = biquadCascade(packed, ALT_BIQUAD_SECTIONS, (2000 + (i & 255)) << ALT_FILTER_SHIFT);
+    }
+    double packedNs = (double) (hostNs() - start) / SAMPLES;
+    start = hostNs();
+    for (i = 0; i < SAMPLES; i++) {
+        sink = scalarCascade(scalar, ALT_BIQUAD_SECTIONS, (2000 + (i & 255)) << ALT_FILTER_SHIFT);
+    }
+    double scalarNs = (double) (hostNs() - start) / SAMPLES;
+    (void) sink;
+    printf("simd: biquad cascade %.1f ns packed, %.1f ns scalar per sample (host)\n",
+           packedNs, scalarNs);
+
+    //Packed buffer against a word per sample, same contents in half the storage
+    static uint32_t words[BUF_SIZE];
+    static uint32_t packedWords[CIRCBUF16_WORDS(BUF_SIZE)];
+    circBuf_t wide;
+    circBuf16_t narrow;
+    initCircBuf(&wide, words, BUF_SIZE);
+    initCircBuf16(&narrow, packedWords, BUF_SIZE);
+    uint32_t wideSum = 0;
+    uint32_t narrowSum = 0;
+    for (i = 0; i < 100000; i++) {
+        uint16_t v = nextRandom() & 0xFFF;
+        wideSum += v - writeCircBuf(&wide, v);
+        narrowSum += v - writeCircBuf16(&narrow, v);
+        if (i % 997 == 0) {
+            uint32_t j;
+            uint32_t loopSum = 0;
+            for (j = 0; j < BUF_SIZE; j++) {
+                uint32_t w = readCircBuf(&wide);
+                CHECK(w == readCircBuf16(&narrow), "buffers differ at entry %u", j);
+                loopSum += w;
+            }
+            CHECK(wideSum == loopSum && narrowSum == loopSum,
+                  "running sums %u %u, buffer holds %u", wideSum, narrowSum, loopSum);
+        }
+    }
+    printf("simd: %u samples in %u bytes packed, %u bytes a word each\n", BUF_SIZE,
+           (unsigned) sizeof(packedWords), (unsigned) sizeof(words));
+
+    //Write plus mean: running sum on the packed buffer against the old loop over every entry
+    volatile uint32_t mean = 0;
+    start = hostNs();
+    for (i = 0; i < SAMPLES; i++) {
+        narrowSum += (i & 0xFFF) - writeCircBuf16(&narrow, i & 0xFFF);
+        mean = narrowSum / BUF_SIZE;
+    }
+    double runningNs = (double) (hostNs() - start) / SAMPLES;
+    start = hostNs();
+    for (i = 0; i < SAMPLES / 16; i++) {
+        uint32_t j;
+        uint32_t sum = 0;
+        writeCircBuf(&wide, i & 0xFFF);
+        for (j = 0; j < BUF_SIZE; j++) {
+            sum += readCircBuf(&wide);
+        }
+        mean = sum / BUF_SIZE;
+    }
+    double loopNs = (double) (hostNs() - start) / (SAMPLES / 16);
+    (void) mean;
+    printf("simd: write and mean %.1f ns with the packed running sum, %.1f ns summing every "
+           "entry (host)\n", runningNs, loopNs);
+    CHECK(runningNs < loopNs, "running sum slower than the loop it replaced");
+
+    return hostResult("simdTest");
+}
@@ -0,0 +1,3 @@
+#pragma once
+void OLEDInitialise(void);
+void OLEDStringDraw(const char *, unsigned long, unsigned long);
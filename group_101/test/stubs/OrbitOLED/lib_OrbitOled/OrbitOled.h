@@ -0,0 +1,2 @@
+#pragma once
+void OrbitOledClear(void);
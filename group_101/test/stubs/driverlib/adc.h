@@ -0,0 +1,26 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#define ADC_TRIGGER_PROCESSOR 0
+#define ADC_TRIGGER_PWM0 6
+#define ADC_TRIGGER_PWM1 7
+#define ADC_TRIGGER_PWM2 8
+#define ADC_TRIGGER_PWM3 9
+#define ADC_CTL_CH9 9
+#define ADC_CTL_IE 0x40
+#define ADC_CTL_END 0x20
+#define ADC_TRIGGER_PWM_MOD0 0
+void ADCSequenceConfigure(uint32_t, uint32_t, uint32_t, uint32_t);
+void ADCSequenceStepConfigure(uint32_t, uint32_t, uint32_t, uint32_t);
+void ADCSequenceEnable(uint32_t, uint32_t);
+void ADCSequenceDisable(uint32_t, uint32_t);
+void ADCIntRegister(uint32_t, uint32_t, void (*)(void));
+void ADCIntEnable(uint32_t, uint32_t);
+void ADCIntClear(uint32_t, uint32_t);
+int32_t ADCSequenceDataGet(uint32_t, uint32_t, uint32_t *);
+void ADCProcessorTrigger(uint32_t, uint32_t);
+void ADCPhaseDelaySet(uint32_t, uint32_t);
+#define ADC_PHASE_0 0
+#define ADC_PHASE_180 8
+#define ADC_TRIGGER_TIMER 5
+void ADCHardwareOversampleConfigure(uint32_t, uint32_t);
@@ -0,0 +1,6 @@
+#pragma once
+#include <stdint.h>
+uint32_t EEPROMInit(void);
+void EEPROMRead(uint32_t *, uint32_t, uint32_t);
+uint32_t EEPROMProgram(uint32_t *, uint32_t, uint32_t);
+#define EEPROM_INIT_OK 0
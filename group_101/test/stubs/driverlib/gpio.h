@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#define GPIO_PIN_0 1
+#define GPIO_PIN_1 2
+#define GPIO_PIN_2 4
+#define GPIO_PIN_3 8
+#define GPIO_PIN_4 16
+#define GPIO_PIN_5 32
+#define GPIO_PIN_6 64
+#define GPIO_PIN_7 128
+#define GPIO_STRENGTH_2MA 1
+#define GPIO_PIN_TYPE_STD_WPD 1
+#define GPIO_PIN_TYPE_STD_WPU 2
+#define GPIO_BOTH_EDGES 1
+#define GPIO_LOW_LEVEL 2
+#define GPIO_FALLING_EDGE 3
+void GPIOIntRegister(uint32_t, void (*)(void));
+void GPIOPinTypeGPIOInput(uint32_t, uint8_t);
+void GPIOPinTypeGPIOOutput(uint32_t, uint8_t);
+void GPIOPinTypePWM(uint32_t, uint8_t);
+void GPIOPinTypeUART(uint32_t, uint8_t);
+void GPIOPinTypeADC(uint32_t, uint8_t);
+void GPIOPinConfigure(uint32_t);
+void GPIOIntTypeSet(uint32_t, uint8_t, uint32_t);
+void GPIOIntEnable(uint32_t, uint32_t);
+void GPIOIntDisable(uint32_t, uint32_t);
+uint32_t GPIOIntStatus(uint32_t, bool);
+void GPIOIntClear(uint32_t, uint32_t);
+int32_t GPIOPinRead(uint32_t, uint8_t);
+void GPIOPinWrite(uint32_t, uint8_t, uint8_t);
+void GPIOPadConfigSet(uint32_t, uint8_t, uint32_t, uint32_t);
+void GPIODirModeSet(uint32_t, uint8_t, uint32_t);
+#define GPIO_DIR_MODE_IN 0
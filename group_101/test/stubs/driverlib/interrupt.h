@@ -0,0 +1,8 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+bool IntMasterEnable(void);
+bool IntMasterDisable(void);
+void IntEnable(uint32_t);
+void IntRegister(uint32_t, void (*)(void));
+void IntPrioritySet(uint32_t, uint8_t);
@@ -0,0 +1,5 @@
+#pragma once
+#define GPIO_PC5_M0PWM7 1
+#define GPIO_PF1_M1PWM5 2
+#define GPIO_PA0_U0RX 3
+#define GPIO_PA1_U0TX 4
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#define PWM_GEN_0 0x40
+#define PWM_GEN_1 0x80
+#define PWM_GEN_2 0xC0
+#define PWM_GEN_3 0x100
+#define PWM_OUT_5 0xC1
+#define PWM_OUT_7 0x101
+#define PWM_OUT_5_BIT 0x20
+#define PWM_OUT_7_BIT 0x80
+#define PWM_GEN_MODE_UP_DOWN 2
+#define PWM_GEN_MODE_NO_SYNC 0
+#define PWM_GEN_MODE_SYNC 0x28
+#define PWM_GEN_MODE_GEN_SYNC_LOCAL 0x280
+#define PWM_GEN_MODE_DBG_RUN 4
+#define PWM_GEN_3_BIT 8
+#define PWM_GEN_2_BIT 4
+#define PWM_TR_CNT_ZERO 1
+#define PWM_TR_CNT_LOAD 2
+#define PWM_TR_CNT_AU 4
+#define PWM_TR_CNT_AD 8
+#define PWM_INT_CNT_ZERO 1
+#define PWM_INT_CNT_LOAD 2
+void PWMGenConfigure(uint32_t, uint32_t, uint32_t);
+void PWMGenPeriodSet(uint32_t, uint32_t, uint32_t);
+uint32_t PWMGenPeriodGet(uint32_t, uint32_t);
+void PWMPulseWidthSet(uint32_t, uint32_t, uint32_t);
+void PWMGenEnable(uint32_t, uint32_t);
+void PWMOutputState(uint32_t, uint32_t, bool);
+void PWMSyncUpdate(uint32_t, uint32_t);
+void PWMSyncTimeBase(uint32_t, uint32_t);
+void PWMGenIntTrigEnable(uint32_t, uint32_t, uint32_t);
+void PWMGenIntRegister(uint32_t, uint32_t, void (*)(void));
+void PWMGenIntClear(uint32_t, uint32_t, uint32_t);
+void PWMIntEnable(uint32_t, uint32_t);
+#define PWM_INT_GEN_3 8
+#define PWM_INT_GEN_2 4
+#define PWM_GEN_MODE_DOWN 0
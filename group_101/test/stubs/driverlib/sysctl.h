@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#define SYSCTL_SYSDIV_10 1
+#define SYSCTL_USE_PLL 0
+#define SYSCTL_OSC_MAIN 0
+#define SYSCTL_XTAL_16MHZ 0
+#define SYSCTL_PWMDIV_1 0
+#define SYSCTL_PERIPH_GPIOA 1
+#define SYSCTL_PERIPH_GPIOB 2
+#define SYSCTL_PERIPH_GPIOC 3
+#define SYSCTL_PERIPH_GPIOD 4
+#define SYSCTL_PERIPH_GPIOE 5
+#define SYSCTL_PERIPH_GPIOF 6
+#define SYSCTL_PERIPH_ADC0 7
+#define SYSCTL_PERIPH_ADC1 8
+#define SYSCTL_PERIPH_PWM0 9
+#define SYSCTL_PERIPH_PWM1 10
+#define SYSCTL_PERIPH_UART0 11
+#define SYSCTL_PERIPH_WDOG0 12
+#define SYSCTL_PERIPH_EEPROM0 13
+#define SYSCTL_PERIPH_TIMER0 14
+#define SYSCTL_CAUSE_WDOG0 0x8
+#define SYSCTL_CAUSE_SW 0x10
+#define SYSCTL_CAUSE_POR 0x2
+#define SYSCTL_CAUSE_EXT 0x1
+void SysCtlClockSet(uint32_t);
+uint32_t SysCtlClockGet(void);
+void SysCtlPeripheralEnable(uint32_t);
+bool SysCtlPeripheralReady(uint32_t);
+void SysCtlPeripheralReset(uint32_t);
+void SysCtlPWMClockSet(uint32_t);
+void SysCtlDelay(uint32_t);
+void SysCtlReset(void);
+void SysCtlSleep(void);
+uint32_t SysCtlResetCauseGet(void);
+void SysCtlResetCauseClear(uint32_t);
+void SysCtlPeripheralSleepEnable(uint32_t);
+void SysCtlPeripheralClockGating(bool);
@@ -0,0 +1,8 @@
+#pragma once
+#include <stdint.h>
+void SysTickPeriodSet(uint32_t);
+uint32_t SysTickPeriodGet(void);
+uint32_t SysTickValueGet(void);
+void SysTickIntRegister(void (*)(void));
+void SysTickIntEnable(void);
+void SysTickEnable(void);
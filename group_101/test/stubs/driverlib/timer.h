@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#define TIMER_CFG_PERIODIC 0x22
+#define TIMER_A 0xff
+void TimerConfigure(uint32_t, uint32_t);
+void TimerLoadSet(uint32_t, uint32_t, uint32_t);
+void TimerControlTrigger(uint32_t, uint32_t, bool);
+void TimerEnable(uint32_t, uint32_t);
+void TimerDisable(uint32_t, uint32_t);
@@ -0,0 +1,25 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#define UART_CONFIG_WLEN_8 0x60
+#define UART_CONFIG_STOP_ONE 0
+#define UART_CONFIG_PAR_NONE 0
+#define UART_INT_RX 0x10
+#define UART_INT_RT 0x40
+void UARTConfigSetExpClk(uint32_t, uint32_t, uint32_t, uint32_t);
+void UARTFIFOEnable(uint32_t);
+void UARTEnable(uint32_t);
+void UARTCharPut(uint32_t, unsigned char);
+bool UARTSpaceAvail(uint32_t);
+bool UARTCharsAvail(uint32_t);
+int32_t UARTCharGetNonBlocking(uint32_t);
+void UARTIntRegister(uint32_t, void (*)(void));
+void UARTIntEnable(uint32_t, uint32_t);
+uint32_t UARTIntStatus(uint32_t, bool);
+void UARTIntClear(uint32_t, uint32_t);
+#define UART_INT_TX 0x20
+#define UART_FIFO_TX2_8 0x01
+#define UART_FIFO_RX4_8 0x10
+void UARTCharPutNonBlocking(uint32_t, unsigned char);
+void UARTIntDisable(uint32_t, uint32_t);
+void UARTFIFOLevelSet(uint32_t, uint32_t, uint32_t);
@@ -0,0 +1,13 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+void WatchdogReloadSet(uint32_t, uint32_t);
+void WatchdogResetEnable(uint32_t);
+void WatchdogEnable(uint32_t);
+void WatchdogStallEnable(uint32_t);
+void WatchdogIntClear(uint32_t);
+void WatchdogIntRegister(uint32_t, void (*)(void));
+void WatchdogUnlock(uint32_t);
+void WatchdogLock(uint32_t);
+bool WatchdogLockState(uint32_t);
+bool WatchdogRunning(uint32_t);
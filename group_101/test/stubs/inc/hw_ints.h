@@ -0,0 +1,6 @@
+#pragma once
+#define INT_WATCHDOG 34
+#define INT_UART0 21
+#define INT_PWM0_3 61
+#define INT_ADC0SS3 33
+#define INT_ADC1SS3 67
@@ -0,0 +1,17 @@
+#pragma once
+#define GPIO_PORTA_BASE 0x40004000
+#define GPIO_PORTB_BASE 0x40005000
+#define GPIO_PORTC_BASE 0x40006000
+#define GPIO_PORTD_BASE 0x40007000
+#define GPIO_PORTE_BASE 0x40024000
+#define GPIO_PORTF_BASE 0x40025000
+#define ADC0_BASE 0x40038000
+#define ADC1_BASE 0x40039000
+#define PWM0_BASE 0x40028000
+#define PWM1_BASE 0x40029000
+#define UART0_BASE 0x4000C000
+#define WATCHDOG0_BASE 0x40000000
+#define TIMER0_BASE 0x40030000
+#define EEPROM_BASE 0x400AF000
+#define NVIC_BASE 0xE000E000
+#define SYSCTL_BASE 0x400FE000
@@ -0,0 +1,4 @@
+#pragma once
+#define NVIC_ST_CURRENT 0xE000E018
+#define NVIC_SYS_CTRL 0xE000ED10
+#define NVIC_SYS_CTRL_SLEEPDEEP 0x4
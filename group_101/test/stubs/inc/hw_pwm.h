@@ -0,0 +1,5 @@
+#pragma once
+#define PWM_O_CTL 0x0
+#define PWM_CTL_GLOBALSYNC3 0x8
+#define PWM_CTL_GLOBALSYNC2 0x4
+#define PWM_O_0_COUNT 0x48
@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+//Registers are plain memory on the host, hostStubs.c keeps a small table of them
+volatile uint32_t *hostRegister (uint32_t addr);
+#define HWREG(x) (*hostRegister(x))
@@ -0,0 +1,7 @@
+#pragma once
+#include "inc/hw_types.h"
+#define GPIO_PORTF_LOCK_R HWREG(0x40025520)
+#define GPIO_PORTF_CR_R HWREG(0x40025524)
+#define GPIO_LOCK_KEY 0x4C4F434B
+#define NVIC_DBG_CTRL_R 0
+#define GPIO_LOCK_M 0xFFFFFFFF
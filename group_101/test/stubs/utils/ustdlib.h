@@ -0,0 +1,4 @@
+#pragma once
+#include <stdarg.h>
+int usprintf(char *, const char *, ...);
+int usnprintf(char *, unsigned long, const char *, ...);
@@ -0,0 +1,163 @@
+/*
+ * supervisorTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Task supervisor and watchdog. Runs the four supervised tasks at their main.c rates with
+// supervisorTick() called every SysTick, then stalls each task in turn and checks that the
+// feed stops once that task passes its deadline and not before, that the watchdog interrupt
+// stops the rotors and records the task, and that the next boot reads the watchdog reset
+// and the missed task back for reportBootReason() and clears the record.
+//
+// The watchdog is modelled as a count of milliseconds since the last feed. Its first
+// timeout calls WatchdogIntHandler(), which spins waiting for the second, so the EEPROM
+// program hook stands in for that reset and jumps back to the test.
+
+#include <setjmp.h>
+#include "hostStubs.h"
+#include "../supervisor.c"
+
+#define SIM_RUN_MS 1000             //Time each task runs before it is stalled
+#define SIM_SLIP_MS 15              //A controller stall short of its deadline
+
+//Task periods in main.c, ms
+static const uint16_t period[NUM_SUP_TASKS] = { 4, 10, 15, 200 };
+
+//Names main.c's reportBootReason() prints for each task
+static const char *reportName[NUM_SUP_TASKS] = { "controller", "buttons", "display",
+                                                 "telemetry" };
+
+static jmp_buf resetPoint;
+static uint32_t lastFeed;
+
+//The watchdog's second timeout, once WatchdogIntHandler() has written the reason
+static void
+watchdogReset (void)
+{
+    longjmp(resetPoint, 1);
+}
+
+//Load time values back into the supervisor then start it as main() does, rotors running
+static void
+boot (uint32_t cause)
+{
+    running = false;
+    missedTasks = 0;
+    bootWatchdogReset = false;
+    bootMissedTasks = 0;
+    hostResetCause = cause;
+    hostPwmOutputs = PWM_MAIN_OUTBIT | PWM_TAIL_OUTBIT;
+    initSupervisor();
+    lastFeed = getSensorTick();
+}
+
+// *******************************************************
+// run: Tick for ms with every task not in stalled checking in at its period. Returns true
+// if the watchdog fired, with lastFeed the tick it was last fed.
+static bool
+run (uint32_t ms, uint8_t stalled)
+{
+    uint32_t end = getSensorTick() + ms;
+
+    while (getSensorTick() != end) {
+        uint32_t feeds = hostWatchdogFeeds;
+        uint32_t now;
+        uint8_t i;
+
+        sensorTick();
+        supervisorTick();
+        now = getSensorTick();
+        if (hostWatchdogFeeds != feeds) {
+            lastFeed = now;
+        }
+        if (now - lastFeed >= SUP_WATCHDOG_MS) {
+            hostEepromProgrammed = watchdogReset;
+            if (!setjmp(resetPoint)) {
+                WatchdogIntHandler();
+            }
+            hostEepromProgrammed = NULL;
+            return true;
+        }
+        for (i = 0; i < NUM_SUP_TASKS; i++) {
+            if (!(stalled & (1 << i)) && now % period[i] == 0) {
+                supervisorCheckIn(i);
+            }
+        }
+    }
+    return false;
+}
+
+
+int
+main (void)
+{
+    uint32_t reason;
+    uint32_t feeds;
+    uint8_t task;
+
+    initPersist();
+
+    //Every task keeping up feeds the watchdog every tick
+    boot(SYSCTL_CAUSE_POR);
+    CHECK(!getBootWatchdogReset(), "power on read as a watchdog reset");
+    feeds = hostWatchdogFeeds;
+    CHECK(!run(SIM_RUN_MS, 0), "watchdog fired with every task keeping up");
+    CHECK(hostWatchdogFeeds - feeds == SIM_RUN_MS, "fed %u times in %u ms",
+          hostWatchdogFeeds - feeds, SIM_RUN_MS);
+
+    //A controller pass running late but inside its deadline leaves the feed alone
+    feeds = hostWatchdogFeeds;
+    run(SIM_SLIP_MS, 1 << TASK_CONTROLLER);
+    run(SIM_RUN_MS, 0);
+    CHECK(hostWatchdogFeeds - feeds == SIM_SLIP_MS + SIM_RUN_MS,
+          "controller %d ms late stopped the feed", SIM_SLIP_MS);
+
+    printf("supervisor: one task stalled, ms from its last check in\n");
+    for (task = 0; task < NUM_SUP_TASKS; task++) {
+        uint32_t stallFrom;
+        uint32_t stopped;
+        bool fired;
+
+        boot(SYSCTL_CAUSE_POR);
+        run(SIM_RUN_MS, 0);
+        stallFrom = getSensorTick() - getSensorTick() % period[task];
+
+        //The feed stops on the first tick past the deadline, and the watchdog expires
+        //SUP_WATCHDOG_MS after the last feed
+        fired = run(deadline[task] + 2 * SUP_WATCHDOG_MS, 1 << task);
+        stopped = lastFeed - stallFrom;
+        printf("  %-10s deadline %3d  last fed %3u  missed 0x%x  watchdog %s\n",
+               getSupTaskName(task), deadline[task], stopped, missedTasks,
+               fired ? "fired" : "did not fire");
+        CHECK(stopped == deadline[task], "%s last fed %u ms after its check in, deadline %d",
+              getSupTaskName(task), stopped, deadline[task]);
+        CHECK(missedTasks == 1 << task, "%s stalled but missed reads 0x%x",
+              getSupTaskName(task), missedTasks);
+        CHECK(fired, "%s stalled and the watchdog never fired", getSupTaskName(task));
+        CHECK(hostPwmOutputs == 0, "rotors left on by the watchdog interrupt");
+        CHECK(persistRead(PERSIST_RESET_REASON, &reason) && reason == 1 << task,
+              "reset reason 0x%x recorded for %s", reason, getSupTaskName(task));
+
+        //The next boot reads back what reportBootReason() sends, then clears the record
+        boot(SYSCTL_CAUSE_WDOG0);
+        CHECK(getBootWatchdogReset(), "watchdog reset not seen at boot");
+        CHECK(getBootMissedTasks() == 1 << task, "boot read missed 0x%x, not 0x%x",
+              getBootMissedTasks(), 1 << task);
+        CHECK(strcmp(getSupTaskName(task), reportName[task]) == 0,
+              "task %d reported as %s", task, getSupTaskName(task));
+        CHECK(hostResetCause == 0, "reset cause 0x%x left uncleared", hostResetCause);
+        CHECK(persistRead(PERSIST_RESET_REASON, &reason) && reason == 0,
+              "reset reason 0x%x still recorded after boot", reason);
+    }
+
+    //A power on after a watchdog reset does not report the stale reason again
+    persistWrite(PERSIST_RESET_REASON, 1 << TASK_UART);
+    boot(SYSCTL_CAUSE_POR);
+    CHECK(!getBootWatchdogReset() && getBootMissedTasks() == 0,
+          "power on reported a watchdog reset, missed 0x%x", getBootMissedTasks());
+
+    return hostResult("supervisorTest");
+}
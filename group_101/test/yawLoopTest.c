@@ -0,0 +1,359 @@
+/*
+ * yawLoopTest.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+// *******************************************************
+// Dual rate tail controller. Flies a yaw step on a tail plant with the yaw rate loop run
+// every SysTick and the position loop every CONTROL_PERIOD, as main.c schedules them, and
+// checks the hand off between the two, that the inner loop moves the tail between
+// controller ticks, and that setDuty() leaves the caller's interrupt mask alone. Then flies
+// a hold with the rotors seeing the duty in hundredths and in whole percent, to show the
+// limit cycle the coarser step leaves, steps the main rotor with the yaw held under the
+// static KC coupling and the dynamic model, and times the SysTick work and the controller
+// tick against their periods.
+//
+// Encoder edges come from the plant through GPIOYawHandler() on the simulated cycle
+// counter. Duty latches at each PWM period as the hardware does. The plant's reaction
+// torque, steady and spin up, is SIM_KC_ERROR over the coupling model so the rate loop
+// integral has work to do.
+// Run with --plant plant.txt to fly a tail axis model fitted by tools/sysidFit.py.
+//
+// Timings are host time scaled by HOST_SLOWDOWN, a deliberately pessimistic ratio between
+// this machine and the 20 MHz Cortex-M4 with no flash wait states.
+
+#include <math.h>
+#include "hostStubs.h"
+#include "../pwmDriver.c"
+#include "../pwmRotor.c"
+#include "../quadrature.c"
+#include "../mixer.h"
+
+#define SIM_CLOCK 20000000          //System clock, cycles per second
+#define SIM_STEP_CYCLES 1000        //Plant step, 50 us
+#define SIM_TICK_MS (int) (DELTA_T * 1000 + 0.5)    //CONTROL_PERIOD in main.c
+#define SIM_YAW_A 1.5               //Yaw rate pole, 1/s
+#define SIM_YAW_B 100.0             //Yaw acceleration, counts/s^2 per percent of tail duty
+#define SIM_KC_ERROR 1.1            //Reaction torque over the coupling model's
+#define SIM_STEP_DEG 45             //Yaw step
+#define SIM_SETTLE_COUNTS 2         //Settled within this many encoder counts
+#define HOST_SLOWDOWN 300           //Target time over host time, pessimistic
+#define ISR_SHARE 10                //Percent of the SysTick period the yaw rate work may take
+#define TICK_SHARE 10               //Percent of the control period the controller tick may take
+#define SIM_HOLD 20.0               //Hold flown at each duty resolution, s
+#define SIM_MAIN_STEP 15            //Main duty step with the yaw held, percent
+#define BENCH_CALLS 1000000
+
+//Quadrature states in clockwise order, GPIOYawHandler() counts up through them
+static const uint8_t cwStates[4] = { 0x00, 0x02, 0x03, 0x01 };
+
+//Tail plant, yaw in counts from the start and rate in counts/s, and the rotors as latched
+typedef struct {
+    double yaw;
+    double rate;
+    double mainLag;
+    int32_t count;
+    uint32_t mainDuty;
+    uint32_t tailDuty;
+} plant_t;
+
+//Plant model in use
+static double plantA = SIM_YAW_A;
+static double plantB = SIM_YAW_B;
+
+static int32_t thrustCommand = 0;  //Thrust about hover the controller tick asks for
+static uint32_t remixes = 0;
+static uint32_t ticks = 0;
+
+//Duty resolution the rotors see, DUTY_SCALE units. DUTY_SCALE is the whole percent the
+//duty was carried in before hundredths.
+static uint32_t dutyStep = 1;
+
+//Duty as latched at the resolution in use
+static uint32_t
+quantise (uint32_t duty)
+{
+    return (duty + dutyStep / 2) / dutyStep * dutyStep;
+}
+
+//Step the plant and raise an encoder edge for every count it crosses
+static void
+plantStep (plant_t *p)
+{
+    double dt = (double) SIM_STEP_CYCLES / SIM_CLOCK;
+    double spinUp = (p->mainDuty - p->mainLag) / COUPLING_TAU;
+    double torque;
+
+    p->mainLag += spinUp * dt;
+    torque = ((double) p->tailDuty - SIM_KC_ERROR * (KC * p->mainLag + COUPLING_KR * spinUp)) /
+             DUTY_SCALE;
+    p->rate += (plantB * torque - plantA * p->rate) * dt;
+    p->yaw += p->rate * dt;
+
+    while (floor(p->yaw) != p->count) {
+        p->count += p->yaw > p->count ? 1 : -1;
+        hostGpioPins = cwStates[p->count & 3];
+        GPIOYawHandler();
+    }
+}
+
+//The yaw rate work in SysTickIntHandler()
+static void
+sysTickYaw (void)
+{
+    int32_t remixDuty[NUM_ACTUATORS];
+    int32_t yawCut;
+
+    yawRateUpdate();
+    if (mixerRemix(AXIS_YAW, controllerTailRate(getYawRate()), remixDuty, &yawCut)) {
+        setDuty(remixDuty[ACT_MAIN], remixDuty[ACT_TAIL]);
+        controllerTailTrack(yawCut);
+        remixes++;
+    }
+}
+
+//The tail side of the controller tick in main(), thrust held at thrustCommand
+static void
+controllerTick (void)
+{
+    int32_t command[NUM_AXES];
+    int32_t duty[NUM_ACTUATORS];
+
+    command[AXIS_THRUST] = thrustCommand;
+    command[AXIS_YAW] = controllerTail(getYawPosition());
+    command[AXIS_TORQUE] = couplingFeedForward(pendingMain, true);
+    mixerApply(command, duty);
+    setDuty(duty[ACT_MAIN], duty[ACT_TAIL]);
+    ticks++;
+}
+
+//One millisecond, a SysTick and a controller tick every control period. Returns true if the
+//rate loop moved the tail between controller ticks. Checks the hand off at every tick.
+static bool
+flyMs (plant_t *p)
+{
+    static uint32_t now = 0;
+    uint32_t pwmPeriod = SIM_CLOCK / PWM_MAIN_FREQ;
+    uint32_t requested = pendingTail;
+    bool moved = false;
+    uint32_t step;
+
+    sysTickYaw();
+    if (now % SIM_TICK_MS != 0 && pendingTail != requested) {
+        moved = true;
+    }
+    if (now % SIM_TICK_MS == 0) {
+        controllerTick();
+        CHECK(yawMixed == yawCommand, "yaw command %d handed to the mixer as %d",
+              (int) yawCommand, (int) yawMixed);
+    }
+    now++;
+
+    for (step = 0; step < SIM_CLOCK / 1000 / SIM_STEP_CYCLES; step++) {
+        hostCycles += SIM_STEP_CYCLES;
+        if (hostCycles % pwmPeriod < SIM_STEP_CYCLES) {
+            p->mainDuty = quantise(pendingMain);
+            p->tailDuty = quantise(pendingTail);
+        }
+        plantStep(p);
+    }
+    return moved;
+}
+
+// *******************************************************
+// flyStep: Step the yaw setpoint by deg and fly for seconds. Returns the settling time and
+// sets the overshoot in counts.
+static double
+flyStep (plant_t *p, int32_t deg, double seconds, double *overshoot)
+{
+    double start = p->yaw;
+    double target = start + (double) deg * YAW_REV / 360;
+    double settle = 0;
+    uint32_t ms;
+    uint32_t tailMoves = 0;
+
+    *overshoot = 0;
+    setYaw(getYawSet() + ANGLE_FROM_DEG(deg));
+    for (ms = 0; ms < seconds * 1000; ms++) {
+        double past;
+
+        if (flyMs(p)) {
+            tailMoves++;
+        }
+        past = (p->yaw - target) * (deg > 0 ? 1 : -1);
+        if (deg != 0 && past > *overshoot) {
+            *overshoot = past;
+        }
+        if (fabs(p->yaw - target) > SIM_SETTLE_COUNTS) {
+            settle = (ms + 1) / 1000.0;
+        }
+    }
+    //The rate loop has to be steering the tail between ticks, not echoing the tick's command
+    printf("    tail moved between ticks %u times in %u ms\n", tailMoves, ms);
+    CHECK(tailMoves > ms / SIM_TICK_MS / 2, "tail only moved between ticks %u times", tailMoves);
+    return settle;
+}
+
+// *******************************************************
+// holdYaw: Hold the present setpoint for seconds and return the yaw's peak to peak over
+// the last half, in counts, and the rms yaw rate in counts/s. Quantised duty leaves the
+// integral hunting between the two levels either side of the torque balance.
+static double
+holdYaw (plant_t *p, double seconds, double *rateRms)
+{
+    double low;
+    double high;
+    double sumSq = 0;
+    uint32_t n = 0;
+    uint32_t ms;
+
+    for (ms = 0; ms < seconds * 500; ms++) {
+        flyMs(p);
+    }
+    low = high = p->yaw;
+    for (ms = 0; ms < seconds * 500; ms++) {
+        flyMs(p);
+        low = fmin(low, p->yaw);
+        high = fmax(high, p->yaw);
+        sumSq += p->rate * p->rate;
+        n++;
+    }
+    *rateRms = sqrt(sumSq / n);
+    return high - low;
+}
+
+#if COUPLING_DYNAMIC
+//Tail row of the mixer for the COUPLING_DYNAMIC 0 build, KC on thrust and no feed-forward,
+//or back to this build's
+static void
+staticCoupling (bool on)
+{
+    mixerSetGain(ACT_TAIL, AXIS_THRUST, on ? (int16_t) (KC * MIXER_UNITY) : 0);
+    mixerSetGain(ACT_TAIL, AXIS_TORQUE, on ? 0 : MIXER_UNITY);
+    mixerSetOffset(ACT_TAIL, on ? (int32_t) (KC * getMixerOffset(ACT_MAIN)) : 0);
+}
+
+// *******************************************************
+// mainStep: Step the main duty up by percent with the yaw held, then back down, and return
+// the worst yaw excursion in counts over either half of seconds.
+static double
+mainStep (plant_t *p, int32_t percent, double seconds)
+{
+    double held;
+    double worst = 0;
+    uint32_t ms;
+
+    for (ms = 0; ms < seconds * 1000; ms++) {
+        flyMs(p);
+    }
+    held = p->yaw;
+    thrustCommand = DUTY_PERCENT(percent);
+    for (ms = 0; ms < seconds * 1000; ms++) {
+        if (ms == seconds * 500) {
+            thrustCommand = 0;
+        }
+        flyMs(p);
+        worst = fmax(worst, fabs(p->yaw - held));
+    }
+    return worst;
+}
+#endif
+
+
+int
+main (int argc, char **argv)
+{
+    plant_t plant = { 0 };
+    double overshoot;
+    double settle;
+    uint64_t start;
+    double isrUs;
+    double tickUs;
+    double peak[2];
+    double rateRms[2];
+    double excursion[2];
+    uint32_t i;
+
+    if (!hostReadPlant(argc, argv, "tail", &plantA, &plantB)) {
+        return 1;
+    }
+    initialisePWM();
+    initQuad();
+    setYawZero();
+    setYaw(0);
+    initTailLoops();
+    hostSimClock = true;
+
+    //Interrupts masked before setDuty() stay masked, unmasked stay unmasked
+    hostIntMasked = true;
+    setDuty(DUTY_PERCENT(GRAVITY), 0);
+    CHECK(hostIntMasked, "setDuty() unmasked interrupts it was called with masked");
+    hostIntMasked = false;
+    setDuty(DUTY_PERCENT(GRAVITY), 0);
+    CHECK(!hostIntMasked, "setDuty() left interrupts masked");
+
+    //Spin up and hold, then step there and back
+    printf("yaw step %d deg, %d counts\n", SIM_STEP_DEG, SIM_STEP_DEG * YAW_REV / 360);
+    flyStep(&plant, 0, 3, &overshoot);
+    settle = flyStep(&plant, SIM_STEP_DEG, 3, &overshoot);
+    printf("  out    settle %.3f s  overshoot %.1f counts\n", settle, overshoot);
+    CHECK(settle < 1.0, "yaw step took %.3f s to settle", settle);
+    CHECK(overshoot < 0.1 * SIM_STEP_DEG * YAW_REV / 360, "yaw step overshot %.1f counts", overshoot);
+    settle = flyStep(&plant, -SIM_STEP_DEG, 3, &overshoot);
+    printf("  back   settle %.3f s  overshoot %.1f counts\n", settle, overshoot);
+    CHECK(settle < 1.0, "yaw step back took %.3f s to settle", settle);
+    CHECK(overshoot < 0.1 * SIM_STEP_DEG * YAW_REV / 360, "yaw step back overshot %.1f counts",
+          overshoot);
+    printf("  %u rate loop passes remixed, %u controller ticks\n", remixes, ticks);
+
+    //Duty resolution, the same hold flown with the rotors seeing hundredths and whole percent.
+    //Hundredths go first, the whole percent cycle leaves the slow position integral wound.
+    for (i = 0; i < 2; i++) {
+        dutyStep = i == 0 ? 1 : DUTY_SCALE;
+        peak[i] = holdYaw(&plant, SIM_HOLD, &rateRms[i]);
+        printf("  hold, duty in %-13s yaw %.2f counts peak to peak, rate %.2f counts/s rms\n",
+               i == 0 ? "hundredths" : "whole percent", peak[i], rateRms[i]);
+    }
+    CHECK(rateRms[0] < rateRms[1] / 2, "hundredths held at %.2f counts/s rms against %.2f",
+          rateRms[0], rateRms[1]);
+    CHECK(peak[0] <= peak[1], "hundredths wandered %.2f counts against %.2f", peak[0], peak[1]);
+    dutyStep = 1;
+
+#if COUPLING_DYNAMIC
+    //Main rotor step with the yaw held, tail cancelling the torque through the static KC gain
+    //and through the lag and spin up model
+    for (i = 0; i < 2; i++) {
+        staticCoupling(i == 0);
+        excursion[i] = mainStep(&plant, SIM_MAIN_STEP, SIM_HOLD);
+        printf("  main %d%% step and back, %-7s coupling  yaw excursion %.1f counts\n",
+               SIM_MAIN_STEP, i == 0 ? "static" : "dynamic", excursion[i]);
+    }
+    CHECK(excursion[1] < excursion[0] / 2, "dynamic coupling yawed %.1f counts against %.1f",
+          excursion[1], excursion[0]);
+#endif
+    CHECK(!hostIntMasked, "the yaw path left interrupts masked");
+
+    //CPU cost, with the cycle counter left on the simulated clock so its reads cost what a
+    //register read does rather than a host clock call
+    start = hostNs();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        sysTickYaw();
+    }
+    isrUs = (double) (hostNs() - start) / BENCH_CALLS * HOST_SLOWDOWN / 1000;
+    start = hostNs();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        controllerTick();
+    }
+    tickUs = (double) (hostNs() - start) / BENCH_CALLS * HOST_SLOWDOWN / 1000;
+
+    printf("  SysTick yaw rate work ~%.1f us, %.1f%% of 1 ms\n", isrUs, isrUs / 10);
+    printf("  controller tail tick  ~%.1f us, %.1f%% of %d ms\n", tickUs,
+           tickUs / (10 * SIM_TICK_MS), SIM_TICK_MS);
+    CHECK(isrUs < 10 * ISR_SHARE, "yaw rate work over %d%% of the SysTick period", ISR_SHARE);
+    CHECK(tickUs < 10 * SIM_TICK_MS * TICK_SHARE, "tail tick over %d%% of the control period",
+          TICK_SHARE);
+
+    return hostResult("yawLoopTest");
+}
@@ -35,11 +35,13 @@ SECTIONS
     .pinit  :   > FLASH
     .init_array : > FLASH
 
-    .vtable :   > 0x20000000
-    .data   :   > SRAM
-    .bss    :   > SRAM
-    .sysmem :   > SRAM
+    .vtable :   > 0x20000000, SIZE(__vtable_size)
+    .data   :   > SRAM, SIZE(__data_size)
+    .bss    :   > SRAM, SIZE(__bss_size)
+    .sysmem :   > SRAM, SIZE(__sysmem_size)
     .stack  :   > SRAM
 }
 
+/* Section sizes above are read at run time by stackMon.c for RAM telemetry  */
+
 __STACK_TOP = __stack + 512;
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+#
+# memCheck.py
+#
+#  Created on: 19/10/2026
+#      Author: jwi182, hrc48
+#
+# Check the static memory plan in memPlan.h against a build. Reads the MODULE SUMMARY of
+# the TI linker map, adds up the rw data of the objects each MEM_*_BYTES figure covers and
+# reports any module that has outgrown its figure, with the plan total against the linker's.
+#
+# Usage: memCheck.py [Debug/Week4Lab.map] [memPlan.h]
+# Exit status 1 if any module is over its figure.
+
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# Objects covered by each figure
+PLAN = {
+    'MEM_ADC_BYTES': ['ADC.obj', 'biquad.obj', 'circBufT.obj'],
+    'MEM_UART_BYTES': ['uart.obj'],
+    'MEM_MAIN_BYTES': ['main.obj'],
+    'MEM_MISSION_BYTES': ['mission.obj'],
+    'MEM_DISPLAY_BYTES': ['display.obj', 'fastFmt.obj'],
+    'MEM_SYSID_BYTES': ['sysid.obj'],
+    'MEM_CONTROL_BYTES': ['pwmRotor.obj', 'pid.obj'],
+    'MEM_MIXER_BYTES': ['mixer.obj'],
+    'MEM_PWM_BYTES': ['pwmDriver.obj'],
+    'MEM_HEALTH_BYTES': ['health.obj'],
+    'MEM_HELISTATE_BYTES': ['heliState.obj'],
+    'MEM_HOVER_BYTES': ['hover.obj'],
+    'MEM_QUAD_BYTES': ['quadrature.obj'],
+    'MEM_SENSOR_BYTES': ['sensorState.obj'],
+    'MEM_SUPERVISOR_BYTES': ['supervisor.obj'],
+    'MEM_MPC_BYTES': ['mpc.obj', 'mpcTable.obj'],
+    'MEM_MISC_BYTES': ['buttons4.obj', 'cpuLoad.obj', 'stackMon.obj', 'coupling.obj',
+                       'persist.obj'],
+    'MEM_OLED_BYTES': ['OrbitOLEDInterface.obj', 'OrbitOledGrph.obj', 'OrbitOled.obj',
+                       'OrbitOledChar.obj', 'ChrFont0.obj', 'delay.obj', 'FillPat.obj'],
+    'MEM_VTABLE_BYTES': ['interrupt.obj'],
+    'MEM_STDLIB_BYTES': ['ustdlib.obj'],
+    'MEM_HEAP_BYTES': ['Heap:'],
+    'MEM_STACK_BYTES': ['Stack:'],
+}
+
+
+def readMap(path):
+    # Module name to rw data bytes from the MODULE SUMMARY table
+    rw = {}
+    inSummary = False
+    with open(path) as f:
+        for line in f:
+            if line.startswith('MODULE SUMMARY'):
+                inSummary = True
+                continue
+            if inSummary and line.startswith('LINKER GENERATED'):
+                break
+            if not inSummary:
+                continue
+            fields = line.split()
+            if (len(fields) == 4 and fields[0] != 'Total:' and fields[1].isdigit() and
+                    fields[3].isdigit()):
+                rw[fields[0]] = rw.get(fields[0], 0) + int(fields[3])
+            if fields[:2] == ['Grand', 'Total:']:
+                rw['Grand Total'] = int(fields[4])
+    return rw
+
+
+def readPlan(path):
+    # Evaluate the #define figures, sizeof only ever appears on the fixed width types
+    defines = {}
+    with open(path) as f:
+        text = f.read().replace('\\\n', ' ')
+    for m in re.finditer(r'^#define\s+(\w+)\s+(.*)$', text, re.M):
+        defines[m.group(1)] = m.group(2).split('//')[0].strip()
+
+    def value(name, depth=0):
+        expr = defines[name]
+        expr = re.sub(r'sizeof\s*\(\s*u?int(\d+)_t\s*\)', lambda m: str(int(m.group(1)) // 8),
+                      expr)
+        expr = re.sub(r'\b([A-Z_][A-Z0-9_]*)\b',
+                      lambda m: '(%d)' % value(m.group(1), depth + 1), expr)
+        expr = re.sub(r'\b0x([0-9a-fA-F]+)\b', lambda m: str(int(m.group(1), 16)), expr)
+        return int(eval(expr.replace('/', '//')))
+
+    return {name: value(name) for name in defines if name.startswith('MEM_')}
+
+
+def main():
+    mapPath = sys.argv[1] if len(sys.argv) > 1 else os.path.join(HERE, '..', 'Debug',
+                                                                  'Week4Lab.map')
+    planPath = sys.argv[2] if len(sys.argv) > 2 else os.path.join(HERE, '..', 'memPlan.h')
+    rw = readMap(mapPath)
+    plan = readPlan(planPath)
+
+    over = False
+    covered = set()
+    print('%-22s %8s %8s' % ('figure', 'plan', 'linker'))
+    for name, objects in PLAN.items():
+        used = sum(rw.get(o, 0) for o in objects)
+        covered.update(objects)
+        flag = ''
+        if used > plan[name]:
+            flag = '  OVER'
+            over = True
+        print('%-22s %8d %8d%s' % (name, plan[name], used, flag))
+
+    for module, size in sorted(rw.items()):
+        if module not in covered and module != 'Grand Total' and size > 0:
+            print('%-22s %8s %8d  NOT IN PLAN' % (module, '-', size))
+            over = True
+
+    print('%-22s %8d %8d' % ('MEM_PLAN_BYTES', plan['MEM_PLAN_BYTES'], rw.get('Grand Total', 0)))
+    sys.exit(1 if over else 0)
+
+
+if __name__ == '__main__':
+    main()
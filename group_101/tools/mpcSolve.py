@@ -0,0 +1,428 @@
+#!/usr/bin/env python3
+#
+# mpcSolve.py
+#
+#  Created on: 19/10/2026
+#      Author: jwi182, hrc48
+#
+# Solve the explicit MPC partition for the altitude axis and write the region table that
+# mpc.c evaluates on target. Only the standard library is needed.
+#
+# Model, the rate model from tools/sysidFit.py:
+#   e' = v,  v' = -a v + b u
+# e height above the setpoint in ADC counts, v climb rate in counts/s, u main duty in percent
+# about hover. Discretised with a zero order hold at the MPC period, which the target must
+# run the law at (MPC_PERIOD_TICKS controller ticks).
+#
+# Problem, horizon N:
+#   min  sum_{k=1..N-1} x_k' Q x_k + sum_{k=0..N-1} R u_k^2 + x_N' P x_N,  P from the DARE
+#   s.t. umin <= u_k <= umax            duty limits about hover
+#        -vmax <= v_k <= vmax, k=1..N   climb rate limit
+# solved as a multi-parametric QP in x0 by enumerating active sets. Each optimal active set
+# gives an affine law for u_0 over a convex polygon of states. Being two dimensional the
+# polygons are clipped exactly, redundant half-planes are dropped and neighbouring regions
+# with the same law are merged where their union is convex.
+#
+# Usage: mpcSolve.py [--plant plant.txt] [--hover 31] [-o dir]
+# Writes mpcTable.h and mpcTable.c, by default next to mpc.c.
+
+import argparse
+import itertools
+import math
+import os
+import sys
+
+# Duty limits and defaults that mirror pwmRotor.h and mixer.h
+PWM_DUTY_MAIN_MIN = 15.0
+PWM_DUTY_MAIN_MAX = 80.0
+GRAVITY = 31.0
+ALT_RATE_MAX = 310.0
+DELTA_T = 0.004
+
+# State box the table is built over, wider than the 1240 count altitude range
+E_BOX = 1300.0
+V_BOX = 1000.0
+TOL = 1e-7
+
+
+# ---- Small dense linear algebra, lists of lists ----------------------------------------
+
+def mat(rows, cols, v=0.0):
+    return [[v] * cols for _ in range(rows)]
+
+
+def mul(a, b):
+    return [[sum(a[i][k] * b[k][j] for k in range(len(b))) for j in range(len(b[0]))]
+            for i in range(len(a))]
+
+
+def tr(a):
+    return [list(r) for r in zip(*a)]
+
+
+def add(a, b, s=1.0):
+    return [[a[i][j] + s * b[i][j] for j in range(len(a[0]))] for i in range(len(a))]
+
+
+def solve(a, b):
+    # Solve a x = b for a matrix right hand side, None if singular
+    n = len(a)
+    m = [list(a[i]) + list(b[i]) for i in range(n)]
+    w = len(m[0])
+    for c in range(n):
+        p = max(range(c, n), key=lambda r: abs(m[r][c]))
+        if abs(m[p][c]) < 1e-10:
+            return None
+        m[c], m[p] = m[p], m[c]
+        for r in range(n):
+            if r != c and m[r][c] != 0.0:
+                f = m[r][c] / m[c][c]
+                for k in range(c, w):
+                    m[r][k] -= f * m[c][k]
+    return [[m[i][k] / m[i][i] for k in range(n, w)] for i in range(n)]
+
+
+# ---- Problem set up --------------------------------------------------------------------
+
+def discretise(a, b, ts):
+    phi = math.exp(-a * ts)
+    hv = (1 - phi) / a
+    A = [[1.0, hv], [0.0, phi]]
+    B = [[b * (ts - hv) / a], [b * hv]]
+    return A, B
+
+
+def dare(A, B, Q, R):
+    P = Q
+    for _ in range(100000):
+        BtP = mul(tr(B), P)
+        S = R + mul(BtP, B)[0][0]
+        BtPA = mul(BtP, A)
+        Pn = add(add(Q, mul(mul(tr(A), P), A)), mul(tr(BtPA), BtPA), -1.0 / S)
+        if max(abs(Pn[i][j] - P[i][j]) for i in range(2) for j in range(2)) < 1e-12:
+            return Pn
+        P = Pn
+    return P
+
+
+def condense(A, B, Q, R, P, N):
+    # x_k = Sx[k] x0 + sum_j Su[k][j] u_j for k = 1..N
+    Sx = []
+    Su = []
+    Ak = [[1.0, 0.0], [0.0, 1.0]]
+    powers = [Ak]
+    for k in range(1, N + 1):
+        Ak = mul(A, Ak)
+        powers.append(Ak)
+        Sx.append(Ak)
+        Su.append([mul(powers[k - 1 - j], B) if j < k else mat(2, 1) for j in range(N)])
+    H = mat(N, N)
+    F = mat(N, 2)
+    for k in range(N):
+        W = P if k == N - 1 else Q
+        for i in range(N):
+            WSu = mul(W, Su[k][i])
+            for j in range(N):
+                H[i][j] += mul(tr(Su[k][j]), WSu)[0][0]
+            f = mul(tr(WSu), Sx[k])[0]
+            F[i][0] += f[0]
+            F[i][1] += f[1]
+    for i in range(N):
+        H[i][i] += R
+    return H, F, Sx, Su
+
+
+def constraints(Sx, Su, N, umin, umax, vmax):
+    # G U <= w + S x, rows in pairs so a pair can never be active together
+    G = []
+    w = []
+    S = []
+    for k in range(N):
+        row = [0.0] * N
+        row[k] = 1.0
+        G.append(row)
+        w.append(umax)
+        S.append([0.0, 0.0])
+        G.append([-v for v in row])
+        w.append(-umin)
+        S.append([0.0, 0.0])
+    for k in range(N):
+        row = [Su[k][j][1][0] for j in range(N)]
+        G.append(row)
+        w.append(vmax)
+        S.append([-Sx[k][1][0], -Sx[k][1][1]])
+        G.append([-v for v in row])
+        w.append(vmax)
+        S.append([Sx[k][1][0], Sx[k][1][1]])
+    return G, w, S
+
+
+def criticalRegion(H, F, G, w, S, active):
+    # KKT for the active set: H U + F x + G_A' lam = 0, G_A U = w_A + S_A x
+    N = len(H)
+    m = len(active)
+    K = mat(N + m, N + m)
+    for i in range(N):
+        for j in range(N):
+            K[i][j] = H[i][j]
+    for a, c in enumerate(active):
+        for j in range(N):
+            K[N + a][j] = G[c][j]
+            K[j][N + a] = G[c][j]
+    rhs = mat(N + m, 3)
+    for i in range(N):
+        rhs[i] = [-F[i][0], -F[i][1], 0.0]
+    for a, c in enumerate(active):
+        rhs[N + a] = [S[c][0], S[c][1], w[c]]
+    sol = solve(K, rhs)
+    if sol is None:
+        return None
+    U = sol[:N]
+    lam = sol[N:]
+    # Half-planes h0 e + h1 v <= k
+    planes = []
+    for c in range(len(G)):
+        if c in active:
+            continue
+        g = [sum(G[c][j] * U[j][t] for j in range(N)) for t in range(3)]
+        planes.append((g[0] - S[c][0], g[1] - S[c][1], w[c] - g[2]))
+    for l in lam:
+        planes.append((-l[0], -l[1], l[2]))
+    return U[0], planes
+
+
+# ---- Two dimensional polygons ----------------------------------------------------------
+
+def clip(poly, plane):
+    h0, h1, k = plane
+    out = []
+    n = len(poly)
+    for i in range(n):
+        p = poly[i]
+        q = poly[(i + 1) % n]
+        dp = h0 * p[0] + h1 * p[1] - k
+        dq = h0 * q[0] + h1 * q[1] - k
+        if dp <= 0:
+            out.append(p)
+        if (dp < 0 < dq) or (dq < 0 < dp):
+            t = dp / (dp - dq)
+            out.append((p[0] + t * (q[0] - p[0]), p[1] + t * (q[1] - p[1])))
+    return out
+
+
+def area(poly):
+    return 0.5 * abs(sum(poly[i][0] * poly[(i + 1) % len(poly)][1] -
+                         poly[(i + 1) % len(poly)][0] * poly[i][1] for i in range(len(poly))))
+
+
+def hull(points):
+    pts = sorted(set(points))
+    if len(pts) < 3:
+        return pts
+
+    def cross(o, a, b):
+        return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0])
+
+    lower = []
+    for p in pts:
+        while len(lower) >= 2 and cross(lower[-2], lower[-1], p) <= 0:
+            lower.pop()
+        lower.append(p)
+    upper = []
+    for p in reversed(pts):
+        while len(upper) >= 2 and cross(upper[-2], upper[-1], p) <= 0:
+            upper.pop()
+        upper.append(p)
+    return lower[:-1] + upper[:-1]
+
+
+BOX = [(-E_BOX, -V_BOX), (E_BOX, -V_BOX), (E_BOX, V_BOX), (-E_BOX, V_BOX)]
+
+
+def onBox(p, q):
+    for axis, lim in ((0, E_BOX), (1, V_BOX)):
+        for s in (-lim, lim):
+            if abs(p[axis] - s) < 1e-6 * lim and abs(q[axis] - s) < 1e-6 * lim:
+                return True
+    return False
+
+
+def edgePlanes(poly):
+    # Half-planes along the polygon edges, normalised, box edges left out.
+    # The polygon is counter-clockwise so the interior is to the left of each edge.
+    if sum(poly[i][0] * poly[(i + 1) % len(poly)][1] -
+           poly[(i + 1) % len(poly)][0] * poly[i][1] for i in range(len(poly))) < 0:
+        poly = list(reversed(poly))
+    planes = []
+    for i in range(len(poly)):
+        p = poly[i]
+        q = poly[(i + 1) % len(poly)]
+        if onBox(p, q):
+            continue
+        h0 = q[1] - p[1]
+        h1 = p[0] - q[0]
+        norm = math.hypot(h0, h1)
+        if norm < 1e-9:
+            continue
+        h0 /= norm
+        h1 /= norm
+        planes.append((h0, h1, h0 * p[0] + h1 * p[1]))
+    return planes
+
+
+# ---- Partition -------------------------------------------------------------------------
+
+def partition(H, F, G, w, S, N):
+    pairs = len(G) // 2
+    regions = []
+    for choice in itertools.product((0, 1, 2), repeat=pairs):
+        active = [2 * i + c - 1 for i, c in enumerate(choice) if c]
+        if len(active) > N:
+            continue
+        cr = criticalRegion(H, F, G, w, S, active)
+        if cr is None:
+            continue
+        law, planes = cr
+        poly = BOX
+        for plane in planes:
+            poly = clip(poly, plane)
+            if len(poly) < 3:
+                break
+        if len(poly) >= 3 and area(poly) > 1e-6 * 4 * E_BOX * V_BOX:
+            regions.append({'law': tuple(law), 'poly': poly})
+    return regions
+
+
+def sameLaw(a, b):
+    return all(abs(x - y) <= 1e-6 * (1 + abs(x)) for x, y in zip(a, b))
+
+
+def merge(regions):
+    changed = True
+    while changed:
+        changed = False
+        for i in range(len(regions)):
+            for j in range(i + 1, len(regions)):
+                ri = regions[i]
+                rj = regions[j]
+                if not sameLaw(ri['law'], rj['law']):
+                    continue
+                h = hull(ri['poly'] + rj['poly'])
+                if abs(area(h) - area(ri['poly']) - area(rj['poly'])) < 1e-6 * area(h):
+                    regions[i] = {'law': ri['law'], 'poly': h}
+                    del regions[j]
+                    changed = True
+                    break
+            if changed:
+                break
+    return regions
+
+
+def readPlant(path):
+    params = {}
+    with open(path) as f:
+        for line in f:
+            line = line.split('#')[0]
+            if '=' in line:
+                key, value = line.split('=', 1)
+                params[key.strip()] = value.strip()
+    if params.get('axis', 'main') != 'main':
+        sys.exit('plant file is not for the main axis')
+    return float(params['rate_a']), float(params['rate_b'])
+
+
+def fmt(x):
+    # Round-off from the clipping is printed as zero
+    if abs(x) < 1e-9:
+        x = 0.0
+    s = '%.7g' % x
+    if 'e' not in s and '.' not in s:
+        s += '.0'
+    return s
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Solve the explicit altitude MPC table')
+    parser.add_argument('--plant', help='parameter file from sysidFit.py')
+    parser.add_argument('--a', type=float, default=2.0, help='velocity pole, 1/s')
+    parser.add_argument('--b', type=float, default=40.0, help='counts/s^2 per percent')
+    parser.add_argument('--period-ticks', type=int, default=5,
+                        help='controller ticks per MPC step')
+    parser.add_argument('--horizon', type=int, default=4)
+    parser.add_argument('--qe', type=float, default=1.0)
+    parser.add_argument('--qv', type=float, default=0.02)
+    parser.add_argument('--r', type=float, default=80.0)
+    parser.add_argument('--hover', type=float, default=GRAVITY, help='hover duty, percent')
+    parser.add_argument('--vmax', type=float, default=ALT_RATE_MAX, help='counts/s')
+    parser.add_argument('-o', '--outdir',
+                        default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+    args = parser.parse_args()
+
+    a, b = readPlant(args.plant) if args.plant else (args.a, args.b)
+    ts = DELTA_T * args.period_ticks
+    N = args.horizon
+    umin = PWM_DUTY_MAIN_MIN - args.hover
+    umax = PWM_DUTY_MAIN_MAX - args.hover
+
+    A, B = discretise(a, b, ts)
+    Q = [[args.qe, 0.0], [0.0, args.qv]]
+    P = dare(A, B, Q, args.r)
+    H, F, Sx, Su = condense(A, B, Q, args.r, P, N)
+    G, w, S = constraints(Sx, Su, N, umin, umax, args.vmax)
+
+    regions = merge(partition(H, F, G, w, S, N))
+    regions.sort(key=lambda r: -area(r['poly']))
+    for r in regions:
+        r['planes'] = edgePlanes(r['poly'])
+    maxPlanes = max(len(r['planes']) for r in regions)
+    laws = []
+    for r in regions:
+        if not any(sameLaw(r['law'], l) for l in laws):
+            laws.append(r['law'])
+
+    summary = ('a = %g, b = %g, %g ms steps, horizon %d, Q = diag(%g, %g), R = %g, '
+               'u in [%g, %g], |v| <= %g' % (a, b, ts * 1000, N, args.qe, args.qv, args.r,
+                                             umin, umax, args.vmax))
+    sys.stderr.write('%d regions, %d distinct laws, at most %d half-planes\n'
+                     % (len(regions), len(laws), maxPlanes))
+
+    with open(os.path.join(args.outdir, 'mpcTable.h'), 'w') as f:
+        f.write('''/*
+ * mpcTable.h
+ *
+ *  Generated by tools/mpcSolve.py, do not edit.
+ *  %s
+ */
+
+#define MPC_REGIONS %d
+#define MPC_MAX_PLANES %d
+#define MPC_PERIOD_TICKS %d    //Controller ticks per MPC step, the period the table was solved for
+#define MPC_U_MIN %s
+#define MPC_U_MAX %s
+''' % (summary, len(regions), maxPlanes, args.period_ticks, fmt(umin), fmt(umax)))
+
+    with open(os.path.join(args.outdir, 'mpcTable.c'), 'w') as f:
+        f.write('''/*
+ * mpcTable.c
+ *
+ *  Generated by tools/mpcSolve.py, do not edit.
+ *  %s
+ */
+
+#include "mpc.h"
+
+//Largest region first, unused half-planes are zero
+const mpcRegion_t mpcTable[MPC_REGIONS] = {
+''' % summary)
+        for i, r in enumerate(regions):
+            planes = r['planes'] + [(0.0, 0.0, 0.0)] * (maxPlanes - len(r['planes']))
+            f.write('    { { %s },\n' % ', '.join('{ %s, %s, %s }' % tuple(fmt(x) for x in p)
+                                                  for p in planes))
+            f.write('      { %s, %s, %s }, %d }%s\n'
+                    % (fmt(r['law'][0]), fmt(r['law'][1]), fmt(r['law'][2]),
+                       len(r['planes']), ',' if i < len(regions) - 1 else ''))
+        f.write('};\n')
+
+
+if __name__ == '__main__':
+    main()
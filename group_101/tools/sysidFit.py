@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+#
+# sysidFit.py
+#
+#  Created on: 19/10/2026
+#      Author: jwi182, hrc48
+#
+# Fit discrete-time plant models to a system identification log captured from the
+# telemetry UART after an SD command. Only the standard library is needed.
+#
+# Log format, as sent by sendSysidLog() in main.c:
+#   SysID <M|T> <P|C> <amp %> <samples> <rate Hz> <OK|OVERRUN>
+#   Log <index> <input> <output>
+# input is the duty applied to the excited rotor in hundredths of a percent, output the
+# altitude ADC mean (main) or the yaw in encoder counts (tail). Other lines are ignored,
+# so a raw capture of the serial port can be passed straight in.
+#
+# Models fitted, u in percent duty and y in counts about their means:
+#   ARX      y[k] = -a1 y[k-1] - ... - a_na y[k-na] + b1 u[k-nk] + ... + b_nb u[k-nk-nb+1]
+#   FOPDT    K e^(-Ls) / (tau s + 1), delay searched over whole samples
+#   rate     y' = v, v' = -a v + b u, the integrating model used by tools/mpcSolve.py
+# ARX is an equation error fit. FOPDT and rate are output error fits, simulated and
+# compared with the measured output, so noise on the output does not bias the poles.
+# The main axis output is flipped to height so a positive gain means up.
+#
+# Usage: sysidFit.py log.txt [-o plant.txt] [--na 2] [--nb 2] [--nk 1] [--max-delay 25]
+# Writes key = value lines for tools/mpcSolve.py --plant, and for test/altStepSim (main axis)
+# and test/yawLoopTest (tail axis) run with --plant.
+
+import argparse
+import math
+import sys
+
+
+def parseLog(lines):
+    header = None
+    samples = {}
+    for line in lines:
+        fields = line.split()
+        if len(fields) >= 7 and fields[0] == 'SysID':
+            header = {
+                'axis': 'main' if fields[1] == 'M' else 'tail',
+                'waveform': 'prbs' if fields[2] == 'P' else 'chirp',
+                'amplitude': float(fields[3]),
+                'samples': int(fields[4]),
+                'rate': float(fields[5]),
+                'overrun': fields[6] == 'OVERRUN',
+            }
+            samples = {}
+        elif len(fields) == 4 and fields[0] == 'Log':
+            try:
+                samples[int(fields[1])] = (int(fields[2]), int(fields[3]))
+            except ValueError:
+                pass
+    if header is None:
+        raise ValueError('no SysID header in the log')
+    n = 0
+    while n in samples:
+        n += 1
+    if n < header['samples']:
+        sys.stderr.write('warning: %d of %d samples received, fitting the first %d\n'
+                         % (n, header['samples'], n))
+    u = [samples[i][0] / 100.0 for i in range(n)]
+    y = [float(samples[i][1]) for i in range(n)]
+    if header['axis'] == 'main':
+        y = [-v for v in y]
+    return header, u, y
+
+
+def leastSquares(rows, targets):
+    # Solve the normal equations by Gaussian elimination with partial pivoting
+    n = len(rows[0])
+    a = [[0.0] * (n + 1) for _ in range(n)]
+    for row, t in zip(rows, targets):
+        for i in range(n):
+            for j in range(n):
+                a[i][j] += row[i] * row[j]
+            a[i][n] += row[i] * t
+    for c in range(n):
+        p = max(range(c, n), key=lambda r: abs(a[r][c]))
+        a[c], a[p] = a[p], a[c]
+        if abs(a[c][c]) < 1e-12:
+            raise ValueError('regressors are not persistently excited')
+        for r in range(n):
+            if r != c:
+                f = a[r][c] / a[c][c]
+                for k in range(c, n + 1):
+                    a[r][k] -= f * a[c][k]
+    theta = [a[i][n] / a[i][i] for i in range(n)]
+    sse = sum((t - sum(r * th for r, th in zip(row, theta))) ** 2
+              for row, t in zip(rows, targets))
+    return theta, sse
+
+
+def removeMean(x):
+    m = sum(x) / len(x)
+    return [v - m for v in x], m
+
+
+def fitArx(u, y, na, nb, nk):
+    start = max(na, nk + nb - 1)
+    rows = []
+    targets = []
+    for k in range(start, len(y)):
+        rows.append([-y[k - i] for i in range(1, na + 1)] +
+                    [u[k - nk - i] for i in range(nb)])
+        targets.append(y[k])
+    theta, sse = leastSquares(rows, targets)
+    return theta[:na], theta[na:], sse / len(targets)
+
+
+def delayed(u, d):
+    return [u[0]] * d + u[:len(u) - d]
+
+
+def lagResponse(u, phi):
+    # Unit gain first order lag, zero order hold
+    x = 0.0
+    out = []
+    for uk in u:
+        out.append(x)
+        x = phi * x + (1 - phi) * uk
+    return out
+
+
+def integratingResponse(u, a, ts):
+    # h' = v, v' = -a v + u from rest, exact zero order hold
+    phi = math.exp(-a * ts)
+    hv = (1 - phi) / a
+    hu = (ts - hv) / a
+    h = 0.0
+    v = 0.0
+    out = []
+    for uk in u:
+        out.append(h)
+        h, v = h + hv * v + hu * uk, phi * v + hv * uk
+    return out
+
+
+def outputError(regressors, y):
+    rows = list(zip(*regressors))
+    theta, sse = leastSquares(rows, y)
+    return theta, sse / len(y)
+
+
+def searchPole(fit, lo, hi, maxDelay):
+    # For every delay, a log grid over the pole then golden section around its best point.
+    # fit(pole, d) returns (theta, mse), the parameters linear in the response by least squares.
+    points = 40
+    step = (hi / lo) ** (1.0 / (points - 1))
+    grid = [lo * step ** i for i in range(points)]
+    g = (math.sqrt(5) - 1) / 2
+    best = None
+    for d in range(0, maxDelay + 1):
+        pole = min(grid, key=lambda p: fit(p, d)[1])
+        a, b = pole / step, pole * step
+        for _ in range(25):
+            c1 = b - g * (b - a)
+            c2 = a + g * (b - a)
+            if fit(c1, d)[1] < fit(c2, d)[1]:
+                b = c2
+            else:
+                a = c1
+        pole = (a + b) / 2
+        theta, mse = fit(pole, d)
+        if best is None or mse < best[3]:
+            best = (pole, d, theta, mse)
+    return best
+
+
+def fitFopdt(u, y, ts, maxDelay):
+    # Output error: y = K lag(u delayed) + c, time constant and delay searched
+    ones = [1.0] * len(u)
+
+    def fit(tau, d):
+        return outputError([lagResponse(delayed(u, d), math.exp(-ts / tau)), ones], y)
+
+    tau, d, theta, mse = searchPole(fit, 0.01, 20.0, maxDelay)
+    return theta[0], tau, d, mse
+
+
+def fitRate(u, y, ts, maxDelay):
+    # Output error on height: y = b H(u delayed) + c H(1) + v0 (1 - e^-at) / a + h0, with H the
+    # integrating response. c takes up any offset between the mean duty and true hover.
+    ones = [1.0] * len(u)
+    t = [k * ts for k in range(len(u))]
+
+    def fit(a, d):
+        return outputError([integratingResponse(delayed(u, d), a, ts),
+                            integratingResponse(ones, a, ts),
+                            [(1 - math.exp(-a * tk)) / a for tk in t],
+                            ones], y)
+
+    a, d, theta, mse = searchPole(fit, 0.05, 50.0, maxDelay)
+    return a, theta[0], d, mse
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Fit plant models to a SYSID log')
+    parser.add_argument('log')
+    parser.add_argument('-o', '--output', help='parameter file to write, default stdout')
+    parser.add_argument('--na', type=int, default=2)
+    parser.add_argument('--nb', type=int, default=2)
+    parser.add_argument('--nk', type=int, default=1)
+    parser.add_argument('--max-delay', type=int, default=25, help='samples')
+    args = parser.parse_args()
+
+    with open(args.log) as f:
+        header, u, y = parseLog(f)
+    if header['overrun']:
+        sys.stderr.write('warning: run stopped on a missed controller tick, log is short\n')
+    if len(u) < 50:
+        sys.exit('too few samples to fit')
+
+    ts = 1.0 / header['rate']
+    u0, uMean = removeMean(u)
+    y0, yMean = removeMean(y)
+
+    arxA, arxB, arxMse = fitArx(u0, y0, args.na, args.nb, args.nk)
+
+    gain, tau, d, foMse = fitFopdt(u0, y0, ts, args.max_delay)
+    rateA, rateB, rd, rateMse = fitRate(u0, y0, ts, args.max_delay)
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    out.write('# sysidFit: %s axis, %s, %d samples at %g Hz\n'
+              % (header['axis'], header['waveform'], len(u), header['rate']))
+    out.write('# u in percent duty, y in %s, both about the means below\n'
+              % ('counts of height' if header['axis'] == 'main' else 'encoder counts'))
+    out.write('axis = %s\n' % header['axis'])
+    out.write('ts = %.6g\n' % ts)
+    out.write('u_mean = %.6g\n' % uMean)
+    out.write('y_mean = %.6g\n' % yMean)
+    out.write('arx_nk = %d\n' % args.nk)
+    out.write('arx_a = %s\n' % ' '.join('%.6g' % x for x in arxA))
+    out.write('arx_b = %s\n' % ' '.join('%.6g' % x for x in arxB))
+    out.write('arx_mse = %.6g\n' % arxMse)
+    out.write('fopdt_gain = %.6g\n' % gain)
+    out.write('fopdt_tau = %.6g\n' % tau)
+    out.write('fopdt_delay = %.6g\n' % (d * ts))
+    out.write('fopdt_mse = %.6g\n' % foMse)
+    out.write('rate_a = %.6g\n' % rateA)
+    out.write('rate_b = %.6g\n' % rateB)
+    out.write('rate_delay = %.6g\n' % (rd * ts))
+    out.write('rate_mse = %.6g\n' % rateMse)
+    if args.output:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -6,6 +6,16 @@
  */
 #include "uart.h"
 
+static char rxBuf[UART_RX_LEN + 1];     //Line being received
+static uint8_t rxLen = 0;
+static char rxLine[UART_RX_LEN + 1];    //Last complete line, waiting for UARTGetLine()
+static volatile bool rxLineReady = false;
+
+//Transmit ring, UARTSend() adds at txHead and the TX interrupt drains from txTail
+static char txBuf[UART_TX_LEN];
+static volatile uint16_t txHead = 0;
+static volatile uint16_t txTail = 0;
+static volatile uint32_t txDropped = 0;     //Lines dropped because the ring was full
 
 
 //********************************************************
@@ -33,21 +43,123 @@ initialiseUSB_UART (void)
             UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
             UART_CONFIG_PAR_NONE);
     UARTFIFOEnable(UART_USB_BASE);
+    UARTFIFOLevelSet(UART_USB_BASE, UART_FIFO_TX2_8, UART_FIFO_RX4_8);
     UARTEnable(UART_USB_BASE);
+
+    //Receive command lines and transmit from the ring under interrupt, RT flushes
+    //characters left in the RX FIFO
+    UARTIntRegister(UART_USB_BASE, UARTIntHandler);
+    UARTIntEnable(UART_USB_BASE, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+}
+
+
+//Move characters from the ring into the TX FIFO while it has room
+static void
+txFill (void)
+{
+    uint16_t tail = txTail;
+
+    while (tail != txHead && UARTSpaceAvail(UART_USB_BASE)) {
+        UARTCharPutNonBlocking(UART_USB_BASE, txBuf[tail]);
+        tail = (tail + 1) & (UART_TX_LEN - 1);
+    }
+    txTail = tail;
+}
+
+
+//**********************************************************************
+// UARTIntHandler: Refill the TX FIFO from the ring as it drains, and collect
+// received characters into a line, a CR or LF completes it. A line arriving
+// before the previous one has been collected is dropped.
+//**********************************************************************
+void
+UARTIntHandler (void)
+{
+    uint32_t status = UARTIntStatus(UART_USB_BASE, true);
+    UARTIntClear(UART_USB_BASE, status);
+
+    if (status & UART_INT_TX) {
+        txFill();
+    }
+
+    while (UARTCharsAvail(UART_USB_BASE)) {
+        char c = UARTCharGetNonBlocking(UART_USB_BASE);
+
+        if (c == '\r' || c == '\n') {
+            if (rxLen > 0 && !rxLineReady) {
+                uint8_t i;
+                for (i = 0; i <= rxLen; i++) {
+                    rxLine[i] = rxBuf[i];
+                }
+                rxLineReady = true;
+            }
+            rxLen = 0;
+        } else if (rxLen < UART_RX_LEN) {
+            rxBuf[rxLen++] = c;
+        }
+        rxBuf[rxLen] = '\0';
+    }
+}
+
+
+//**********************************************************************
+// UARTGetLine: Copy out the last complete line, returns false if none is waiting.
+// line must hold UART_RX_LEN + 1 characters.
+//**********************************************************************
+bool
+UARTGetLine (char *line)
+{
+    uint8_t i;
+
+    if (!rxLineReady) {
+        return false;
+    }
+    for (i = 0; i <= UART_RX_LEN; i++) {
+        line[i] = rxLine[i];
+    }
+    rxLineReady = false;
+    return true;
 }
 
 
 //**********************************************************************
-// Transmit a string via UART0
+// UARTSend: Queue a string for UART0 and return without waiting for it to go.
+// A string that does not fit in the ring is dropped whole and counted, so the
+// PC never sees half a line. Main loop only.
 //**********************************************************************
 void
 UARTSend (char *pucBuffer)
 {
-    // Loop while there are more characters to send.
-    while(*pucBuffer)
-    {
-        // Write the next character to the UART Tx FIFO.
-        UARTCharPut(UART_USB_BASE, *pucBuffer);
+    uint16_t head = txHead;
+    uint16_t free = (txTail - head - 1) & (UART_TX_LEN - 1);
+    uint16_t len = 0;
+
+    while (pucBuffer[len]) {
+        len++;
+    }
+    if (len > free) {
+        txDropped++;
+        return;
+    }
+
+    // Copy into the ring, then publish the new head in one write
+    while (*pucBuffer) {
+        txBuf[head] = *pucBuffer;
+        head = (head + 1) & (UART_TX_LEN - 1);
         pucBuffer++;
     }
+    txHead = head;
+
+    // Start the FIFO off, the TX interrupt only fires as it drains
+    UARTIntDisable(UART_USB_BASE, UART_INT_TX);
+    txFill();
+    UARTIntEnable(UART_USB_BASE, UART_INT_TX);
+}
+
+
+//Lines dropped because the transmit ring was full
+uint32_t
+getUARTDropped (void)
+{
+    return txDropped;
 }
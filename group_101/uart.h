@@ -18,7 +18,7 @@
 #include "driverlib/pin_map.h"
 #include "utils/ustdlib.h"
 #include "stdio.h"
-#include "stdlib.h"
+#include "memPlan.h"
 
 
 //---USB Serial comms: UART0, Rx:PA0 , Tx:PA1
@@ -31,7 +31,6 @@
 #define UART_USB_GPIO_PIN_TX    GPIO_PIN_1
 #define UART_USB_GPIO_PINS      UART_USB_GPIO_PIN_RX | UART_USB_GPIO_PIN_TX
 
-#define MAX_STR_LEN 105
 
 
 #ifndef UART_H_
@@ -43,6 +42,15 @@ initialiseUSB_UART (void);
 void
 UARTSend (char *pucBuffer);
 
+void
+UARTIntHandler (void);
+
+bool
+UARTGetLine (char *line);
+
+uint32_t
+getUARTDropped (void);
+
 
 
 #endif /* UART_H_ */
@@ -0,0 +1,43 @@
+/*
+ * yawAngle.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: jwi182, hrc48
+ */
+
+#include <stdint.h>
+
+#define YAW_REV 448                 //Quadrature steps per revolution
+#define ANGLE_PER_COUNT 9586981u    //2^32 / YAW_REV rounded
+#define ANGLE_PER_DEG 11930465u     //2^32 / 360 rounded
+#define ANGLE_CENTI_DEG_REV 36000   //Hundredths of a degree per revolution
+#define INITIAL_YAW_POSITION -223   //Assumed start count until the yaw reference is found
+
+
+#ifndef YAWANGLE_H_
+#define YAWANGLE_H_
+
+// *******************************************************
+// Binary angle: a full revolution is 2^32, so plain unsigned addition and subtraction
+// wrap at +-180 deg for free. Read as int32_t an angle is in [-180, +180) deg, and the
+// difference of two angles is always the shortest signed turn between them.
+typedef uint32_t angle_t;
+
+#define ANGLE_FROM_COUNTS(c) ((angle_t) (int32_t) (c) * ANGLE_PER_COUNT)
+#define ANGLE_FROM_DEG(d)    ((angle_t) (int32_t) (d) * ANGLE_PER_DEG)
+
+//Convert an angle to the nearest signed encoder count in [-YAW_REV/2, YAW_REV/2]
+static inline int32_t
+angleToCounts (angle_t angle)
+{
+    return (int32_t) (((int64_t) (int32_t) angle * YAW_REV + 0x80000000LL) >> 32);
+}
+
+//Convert an angle to signed hundredths of a degree in [-18000, 18000]
+static inline int32_t
+angleToCentiDeg (angle_t angle)
+{
+    return (int32_t) (((int64_t) (int32_t) angle * ANGLE_CENTI_DEG_REV + 0x80000000LL) >> 32);
+}
+
+#endif /* YAWANGLE_H_ */